@@ -0,0 +1,390 @@
+/*
+ * Regression check of all days: golden answers and solving time.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+/*
+ * The golden file lists one input per line as "day file: answer1 answer2",
+ * i.e. the name of the day followed by the line batch mode prints for the
+ * file. Every input is solved several times from memory, the fastest run is
+ * compared with the baseline (a JSON object mapping "day file" to micro-
+ * seconds). The check fails if any answer differs or any input became slower
+ * than the baseline plus threshold. Option -u writes the measured times as new
+ * baseline instead.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "solvers.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_LINE_SIZE       (4096U)  /* max line length of golden file, incl. EOL */
+#define MAX_ENTRIES         (256U)
+#define DEFAULT_REPETITIONS (20U)
+#define DEFAULT_THRESHOLD   (25.0)   /* percent */
+#define NOISE_FLOOR_US      (5.0)    /* ignore differences below this */
+
+typedef struct
+{
+    char* key;       /* "day file" */
+    double time_us;
+} timing_t;
+
+typedef struct
+{
+    timing_t entries[MAX_ENTRIES];
+    size_t used;
+} timings_t;
+
+static int
+read_file(const char* name, char** data, size_t* size);
+
+static int
+run_entry(const solver_t* s, const char* name, unsigned int reps,
+          char* line, size_t line_size, double* time_us);
+
+static int
+baseline_read(timings_t* t, const char* name);
+
+static int
+baseline_write(const timings_t* t, const char* name);
+
+static const timing_t*
+timings_find(const timings_t* t, const char* key);
+
+static int
+timings_add(timings_t* t, const char* key, double time_us);
+
+static void
+timings_free(timings_t* t);
+
+int main(int argc, char *argv[])
+{
+    const char* golden = "golden.txt";
+    const char* baseline = "baseline.json";
+    double threshold = DEFAULT_THRESHOLD;
+    unsigned int reps = DEFAULT_REPETITIONS;
+    int update = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        int ok = 1;
+        if ((strcmp(argv[i], "-u") == 0))
+            update = 1;
+        else if ((strcmp(argv[i], "-g") == 0) && ((i + 1) < argc))
+            golden = argv[++i];
+        else if ((strcmp(argv[i], "-b") == 0) && ((i + 1) < argc))
+            baseline = argv[++i];
+        else if ((strcmp(argv[i], "-t") == 0) && ((i + 1) < argc))
+            ok = (sscanf(argv[++i], "%lf", &threshold) == 1) && (threshold >= 0.0);
+        else if ((strcmp(argv[i], "-r") == 0) && ((i + 1) < argc))
+            ok = (sscanf(argv[++i], "%u", &reps) == 1) && (reps > 0U);
+        else
+            ok = 0;
+
+        if (!ok)
+        {
+            fprintf(stderr,
+                    "Usage: %s [-g golden] [-b baseline] [-t threshold%%] [-r repetitions] [-u]\n",
+                    argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    FILE* fp = fopen(golden, "r");
+    if (!fp)
+    {
+        fprintf(stderr, "Could not open file %s!\n", golden);
+        exit(EXIT_FAILURE);
+    }
+
+    timings_t base = {0};
+    timings_t measured = {0};
+    if (!update && !baseline_read(&base, baseline))
+        printf("No baseline %s, checking answers only.\n", baseline);
+
+    size_t num_ok = 0U;
+    size_t num_wrong = 0U;
+    size_t num_slower = 0U;
+    char line_buf[MAX_LINE_SIZE];
+    char answer[MAX_LINE_SIZE];
+    while (fgets(line_buf, MAX_LINE_SIZE, fp))
+    {
+        line_buf[strcspn(line_buf, "\r\n")] = '\0';
+        /* skip empty lines and comments */
+        if ((line_buf[0] == '\0') || (line_buf[0] == '#'))
+            continue;
+
+        char* file = strchr(line_buf, ' ');
+        char* expected = (file != NULL) ? strstr(file, ": ") : NULL;
+        if (expected == NULL)
+        {
+            fprintf(stderr, "Invalid line %s!\n", line_buf);
+            num_wrong++;
+            continue;
+        }
+        *file++ = '\0';
+        const solver_t* s = solvers_find(line_buf);
+
+        /* key and expected output line share the file name */
+        char key[2U * MAX_LINE_SIZE];
+        *expected = '\0';
+        (void) snprintf(key, sizeof(key), "%s %s", line_buf, file);
+        *expected = ':';
+
+        double time_us = 0.0;
+        if (   (s == NULL)
+            || !run_entry(s, key + strlen(line_buf) + 1U, reps, answer, sizeof(answer), &time_us))
+        {
+            printf("%s: FAILED\n", key);
+            num_wrong++;
+            continue;
+        }
+        answer[strcspn(answer, "\n")] = '\0';
+        if (strcmp(answer, file) != 0)
+        {
+            printf("%s: WRONG\n  expected %s\n  got      %s\n", key, file, answer);
+            num_wrong++;
+            continue;
+        }
+
+        if (!timings_add(&measured, key, time_us))
+        {
+            fprintf(stderr, "Too many inputs!\n");
+            break;
+        }
+
+        const timing_t* b = timings_find(&base, key);
+        if (b == NULL)
+        {
+            printf("%s: ok %.1f us\n", key, time_us);
+            num_ok++;
+        }
+        else
+        {
+            double change = (b->time_us > 0.0) ? (100.0 * (time_us / b->time_us - 1.0)) : 0.0;
+            int slower =    (time_us > (b->time_us * (1.0 + threshold / 100.0)))
+                         && ((time_us - b->time_us) > NOISE_FLOOR_US);
+            printf("%s: %s %.1f us (baseline %.1f us, %+.1f%%)\n",
+                   key, slower ? "SLOWER" : "ok", time_us, b->time_us, change);
+            if (slower)
+                num_slower++;
+            else
+                num_ok++;
+        }
+    }
+    fclose(fp);
+
+    int r = 1;
+    if (update)
+    {
+        r = baseline_write(&measured, baseline);
+        if (r)
+            printf("Baseline written to %s\n", baseline);
+    }
+
+    printf("\n%llu ok, %llu wrong, %llu slower (threshold %.1f%%)\n",
+           (unsigned long long) num_ok,
+           (unsigned long long) num_wrong,
+           (unsigned long long) num_slower,
+           threshold);
+
+    timings_free(&base);
+    timings_free(&measured);
+
+    return (r && (num_wrong == 0U) && (num_slower == 0U)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int
+read_file(const char* name, char** data, size_t* size)
+{
+    FILE* fp = fopen(name, "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return 0;
+    }
+
+    int r = 0;
+    long len;
+    if (   (fseek(fp, 0L, SEEK_END) == 0)
+        && ((len = ftell(fp)) >= 0L)
+        && (fseek(fp, 0L, SEEK_SET) == 0))
+    {
+        /* one extra byte, fmemopen() does not accept empty buffers */
+        *data = malloc((size_t) len + 1U);
+        if (*data != NULL)
+        {
+            *size = fread(*data, 1U, (size_t) len, fp);
+            r = (*size == (size_t) len);
+            if (!r)
+                free(*data);
+        }
+    }
+    fclose(fp);
+
+    return r;
+}
+
+static int
+run_entry(const solver_t* s, const char* name, unsigned int reps,
+          char* line, size_t line_size, double* time_us)
+{
+    char* data;
+    size_t size;
+    if (!read_file(name, &data, &size))
+        return 0;
+
+    void* state = NULL;
+    if (s->create != NULL)
+    {
+        state = s->create();
+        if (state == NULL)
+        {
+            free(data);
+            return 0;
+        }
+    }
+
+    /* the first run checks the answers, the fastest one counts */
+    int r = 1;
+    solver_result_t result;
+    for (unsigned int i = 0U; r && (i < reps); i++)
+    {
+        FILE* fp = fmemopen(data, (size > 0U) ? size : 1U, "r");
+        if (fp == NULL)
+        {
+            r = 0;
+            break;
+        }
+        memset(&result, 0, sizeof(result));
+
+        struct timespec t0;
+        struct timespec t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        r = s->solve(state, fp, NULL, &result);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        fclose(fp);
+
+        double t = (double)(t1.tv_sec - t0.tv_sec) * 1e6 + (double)(t1.tv_nsec - t0.tv_nsec) / 1e3;
+        if ((i == 0U) || (t < *time_us))
+            *time_us = t;
+
+        if (i == 0U)
+        {
+            FILE* out = fmemopen(line, line_size, "w");
+            if (out == NULL)
+            {
+                r = 0;
+                break;
+            }
+            solver_print_line(out, name, r ? &result : NULL);
+            fputc('\0', out);
+            fclose(out);
+        }
+    }
+
+    if (s->destroy != NULL)
+        s->destroy(state);
+    free(data);
+
+    return r;
+}
+
+static int
+baseline_read(timings_t* t, const char* name)
+{
+    char* data;
+    size_t size;
+    if (!read_file(name, &data, &size))
+        return 0;
+    data[size] = '\0';
+
+    /* flat object of strings mapping to numbers, nothing else is expected */
+    int r = 1;
+    char* p = data;
+    while (r && ((p = strchr(p, '"')) != NULL))
+    {
+        char* key = p + 1;
+        char* end = strchr(key, '"');
+        char* colon = (end != NULL) ? strchr(end, ':') : NULL;
+        if (colon == NULL)
+        {
+            r = 0;
+            break;
+        }
+        *end = '\0';
+        double time_us = strtod(colon + 1, &p);
+        r = (p != colon + 1) && timings_add(t, key, time_us);
+    }
+
+    if (!r)
+        fprintf(stderr, "Invalid baseline %s!\n", name);
+    free(data);
+
+    return r;
+}
+
+static int
+baseline_write(const timings_t* t, const char* name)
+{
+    FILE* fp = fopen(name, "w");
+    if (!fp)
+    {
+        fprintf(stderr, "Could not write file %s!\n", name);
+        return 0;
+    }
+
+    fprintf(fp, "{\n");
+    for (size_t i = 0U; i < t->used; i++)
+    {
+        fprintf(fp, "    \"%s\": %.3f%s\n",
+                t->entries[i].key,
+                t->entries[i].time_us,
+                ((i + 1U) < t->used) ? "," : "");
+    }
+    fprintf(fp, "}\n");
+
+    return fclose(fp) == 0;
+}
+
+static const timing_t*
+timings_find(const timings_t* t, const char* key)
+{
+    for (size_t i = 0U; i < t->used; i++)
+        if (strcmp(t->entries[i].key, key) == 0)
+            return &t->entries[i];
+
+    return NULL;
+}
+
+static int
+timings_add(timings_t* t, const char* key, double time_us)
+{
+    if (t->used >= MAX_ENTRIES)
+        return 0;
+
+    t->entries[t->used].key = strdup(key);
+    if (t->entries[t->used].key == NULL)
+        return 0;
+    t->entries[t->used].time_us = time_us;
+    t->used++;
+
+    return 1;
+}
+
+static void
+timings_free(timings_t* t)
+{
+    for (size_t i = 0U; i < t->used; i++)
+        free(t->entries[i].key);
+    t->used = 0U;
+}
@@ -0,0 +1,139 @@
+/*
+ * Client for the solver daemon, sends puzzle inputs and prints the answers.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define CHUNK_SIZE (64U * 1024U)
+
+static int
+request(const struct sockaddr_un* addr, const char* day, const char* name);
+
+static int
+write_all(int fd, const char* data, size_t len);
+
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "Usage: %s socket day file...\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(argv[1]) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Socket path too long!\n");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(addr.sun_path, argv[1]);
+
+    signal(SIGPIPE, SIG_IGN);
+
+    int r = 1;
+    for (int i = 3; i < argc; i++)
+    {
+        if (!request(&addr, argv[2], argv[i]))
+            r = 0;
+    }
+
+    return r ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int
+request(const struct sockaddr_un* addr, const char* day, const char* name)
+{
+    FILE* fp = fopen(name, "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return 0;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (   (fd < 0)
+        || (connect(fd, (const struct sockaddr*) addr, sizeof(*addr)) < 0))
+    {
+        perror("connect");
+        if (fd >= 0)
+            close(fd);
+        fclose(fp);
+        return 0;
+    }
+
+    static char buf[CHUNK_SIZE];
+    int n = snprintf(buf, sizeof(buf), "%s %s\n", day, name);
+    int r = (n > 0) && ((size_t) n < sizeof(buf)) && write_all(fd, buf, (size_t) n);
+
+    size_t len;
+    while (r && ((len = fread(buf, 1U, sizeof(buf), fp)) > 0U))
+        r = write_all(fd, buf, len);
+    fclose(fp);
+
+    /* end of input, the daemon starts solving */
+    if (r)
+        r = (shutdown(fd, SHUT_WR) == 0);
+
+    /* the answer is a single line, solver failures end with "error" */
+    size_t used = 0U;
+    while (r && (used < (sizeof(buf) - 1U)))
+    {
+        ssize_t got = read(fd, &buf[used], sizeof(buf) - 1U - used);
+        if (got < 0)
+        {
+            if (errno != EINTR)
+                r = 0;
+            continue;
+        }
+        if (got == 0)
+            break;
+        used += (size_t) got;
+    }
+    buf[used] = '\0';
+    close(fd);
+
+    if (!r || (used == 0U) || (buf[used - 1U] != '\n'))
+    {
+        fprintf(stderr, "No answer for %s!\n", name);
+        return 0;
+    }
+    fputs(buf, stdout);
+
+    return    (strncmp(buf, "error:", 6U) != 0)
+           && ((used < 7U) || (strcmp(&buf[used - 7U], " error\n") != 0));
+}
+
+static int
+write_all(int fd, const char* data, size_t len)
+{
+    while (len > 0U)
+    {
+        ssize_t n = write(fd, data, len);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return 0;
+        }
+        data += n;
+        len -= (size_t) n;
+    }
+
+    return 1;
+}
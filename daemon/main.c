@@ -0,0 +1,448 @@
+/*
+ * Solver daemon for advent of code 2022, serving requests on a Unix socket.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+/*
+ * Protocol: a client connects, sends a header line "day [label]\n" followed by
+ * the puzzle input and shuts down its sending direction. The daemon answers
+ * with a single line "label: answer1 answer2\n" (see solver_print_line()) and
+ * closes the connection. The label defaults to the name of the day.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "queue.h"
+#include "solvers.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define DEFAULT_WORKERS (4U)
+#define MAX_WORKERS     (64U)
+#define MAX_HEADER_SIZE (256U)                  /* incl. EOL */
+#define MAX_INPUT_SIZE  (256U * 1024U * 1024U)  /* 256 MiB */
+#define CHUNK_SIZE      (64U * 1024U)
+#define BACKLOG         (64)
+
+typedef struct
+{
+    char* data;
+    size_t used;
+    size_t size;
+} buffer_t;
+
+typedef struct
+{
+    void** states;  /* warm state of each day, indexed like the registry */
+    buffer_t buf;   /* request buffer, reused for all requests */
+    pthread_t tid;
+} worker_t;
+
+typedef struct
+{
+    queue_t* connections;
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    int stop;
+} server_t;
+
+static volatile sig_atomic_t terminate = 0;
+static server_t server;
+static size_t num_solvers = 0U;
+
+static void
+on_signal(int sig);
+
+static int
+worker_init(worker_t* w);
+
+static void
+worker_free(worker_t* w);
+
+static void*
+worker_run(void* arg);
+
+static void
+handle_request(worker_t* w, int fd);
+
+static int
+read_request(int fd, buffer_t* buf);
+
+static int
+write_all(int fd, const char* data, size_t len);
+
+int main(int argc, char *argv[])
+{
+    unsigned int workers = DEFAULT_WORKERS;
+    const char* path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-j") == 0)
+        {
+            if (   ((i + 1) >= argc)
+                || (sscanf(argv[i + 1], "%u", &workers) != 1)
+                || (workers == 0U)
+                || (workers > MAX_WORKERS))
+            {
+                fprintf(stderr, "Invalid number of workers!\n");
+                exit(EXIT_FAILURE);
+            }
+            i++;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    if (path == NULL)
+    {
+        fprintf(stderr, "Usage: %s [-j workers] socket\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    while (solvers_get(num_solvers) != NULL)
+        num_solvers++;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Socket path too long!\n");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(addr.sun_path, path);
+
+    int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (lfd < 0)
+    {
+        perror("socket");
+        exit(EXIT_FAILURE);
+    }
+    (void) unlink(path); /* remove stale socket of previous run */
+    if (   (bind(lfd, (struct sockaddr*) &addr, sizeof(addr)) < 0)
+        || (listen(lfd, BACKLOG) < 0))
+    {
+        perror("bind/listen");
+        close(lfd);
+        exit(EXIT_FAILURE);
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal; /* no SA_RESTART, accept() shall return */
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    server.connections = queue_init(sizeof(int));
+    assert(server.connections != NULL);
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_cond_init(&server.ready, NULL);
+    server.stop = 0;
+
+    /* only the main thread shall receive the termination signals */
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    worker_t pool[MAX_WORKERS];
+    unsigned int started = 0U;
+    for (; started < workers; started++)
+    {
+        if (!worker_init(&pool[started]))
+        {
+            fprintf(stderr, "Not enough memory!\n");
+            break;
+        }
+        if (pthread_create(&pool[started].tid, NULL, worker_run, &pool[started]) != 0)
+        {
+            worker_free(&pool[started]);
+            break;
+        }
+    }
+
+    pthread_sigmask(SIG_UNBLOCK, &mask, NULL);
+
+    if (started > 0U)
+    {
+        printf("Listening on %s with %u workers\n", path, started);
+        fflush(stdout);
+    }
+
+    while ((started > 0U) && !terminate)
+    {
+        int fd = accept(lfd, NULL, NULL);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("accept");
+            break;
+        }
+        pthread_mutex_lock(&server.lock);
+        int r = queue_enqueue(server.connections, &fd);
+        pthread_cond_signal(&server.ready);
+        pthread_mutex_unlock(&server.lock);
+        if (!r)
+            close(fd);
+    }
+
+    pthread_mutex_lock(&server.lock);
+    server.stop = 1;
+    pthread_cond_broadcast(&server.ready);
+    pthread_mutex_unlock(&server.lock);
+
+    for (unsigned int i = 0U; i < started; i++)
+    {
+        pthread_join(pool[i].tid, NULL);
+        worker_free(&pool[i]);
+    }
+
+    int fd;
+    while (queue_dequeue(server.connections, &fd))
+        close(fd);
+    queue_destroy(server.connections);
+    free(server.connections);
+    pthread_cond_destroy(&server.ready);
+    pthread_mutex_destroy(&server.lock);
+
+    close(lfd);
+    unlink(path);
+
+    return (started > 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void
+on_signal(int sig)
+{
+    (void) sig;
+    terminate = 1;
+}
+
+static int
+worker_init(worker_t* w)
+{
+    w->buf.size = CHUNK_SIZE;
+    w->buf.used = 0U;
+    w->buf.data = malloc(w->buf.size);
+    w->states = calloc(num_solvers, sizeof(void*));
+    if ((w->buf.data == NULL) || (w->states == NULL))
+    {
+        free(w->buf.data);
+        free(w->states);
+        return 0;
+    }
+
+    /* preallocate all states, so requests never wait for large allocations */
+    for (size_t i = 0U; i < num_solvers; i++)
+    {
+        const solver_t* s = solvers_get(i);
+        if (s->create != NULL)
+        {
+            w->states[i] = s->create();
+            if (w->states[i] == NULL)
+            {
+                worker_free(w);
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+static void
+worker_free(worker_t* w)
+{
+    for (size_t i = 0U; i < num_solvers; i++)
+    {
+        const solver_t* s = solvers_get(i);
+        if ((s->destroy != NULL) && (w->states[i] != NULL))
+            s->destroy(w->states[i]);
+    }
+    free(w->states);
+    free(w->buf.data);
+    w->states = NULL;
+    w->buf.data = NULL;
+}
+
+static void*
+worker_run(void* arg)
+{
+    worker_t* w = arg;
+
+    for (;;)
+    {
+        int fd;
+
+        pthread_mutex_lock(&server.lock);
+        while (!server.stop && (queue_count(server.connections) == 0U))
+            pthread_cond_wait(&server.ready, &server.lock);
+        int r = server.stop ? 0 : queue_dequeue(server.connections, &fd);
+        pthread_mutex_unlock(&server.lock);
+
+        if (!r)
+            break;
+
+        handle_request(w, fd);
+        close(fd);
+    }
+
+    return NULL;
+}
+
+static void
+handle_request(worker_t* w, int fd)
+{
+    char line[MAX_HEADER_SIZE + SOLVER_NUM_PARTS * SOLVER_ANSWER_SIZE + 16U];
+    const char* error = NULL;
+
+    if (!read_request(fd, &w->buf))
+    {
+        error = "invalid request";
+    }
+
+    char day[MAX_HEADER_SIZE] = {0};
+    char label[MAX_HEADER_SIZE] = {0};
+    const char* input = NULL;
+    if (error == NULL)
+    {
+        char* eol = memchr(w->buf.data, '\n', w->buf.used);
+        if (   (eol == NULL)
+            || ((size_t)(eol - w->buf.data) >= MAX_HEADER_SIZE))
+        {
+            error = "invalid header";
+        }
+        else
+        {
+            *eol = '\0';
+            input = eol + 1;
+            int n = sscanf(w->buf.data, "%255s %255[^\n]", day, label);
+            if (n < 1)
+                error = "invalid header";
+            else if (n < 2)
+                strcpy(label, day);
+        }
+    }
+
+    size_t i = 0U;
+    const solver_t* s = NULL;
+    if (error == NULL)
+    {
+        while (((s = solvers_get(i)) != NULL) && (strcmp(s->name, day) != 0))
+            i++;
+        if (s == NULL)
+            error = "unknown day";
+    }
+
+    solver_result_t result;
+    int r = 0;
+    if (error == NULL)
+    {
+        /* buffer is never empty, it contains at least the header */
+        FILE* fp = fmemopen(w->buf.data, w->buf.used, "r");
+        if (   (fp == NULL)
+            || (fseek(fp, (long)(input - w->buf.data), SEEK_SET) != 0))
+        {
+            error = "not enough memory";
+        }
+        else
+        {
+            memset(&result, 0, sizeof(result));
+            r = s->solve(w->states[i], fp, NULL, &result);
+        }
+        if (fp != NULL)
+            fclose(fp);
+    }
+
+    if (error != NULL)
+    {
+        snprintf(line, sizeof(line), "error: %s\n", error);
+    }
+    else
+    {
+        FILE* out = fmemopen(line, sizeof(line), "w");
+        if (out == NULL)
+        {
+            snprintf(line, sizeof(line), "error: not enough memory\n");
+        }
+        else
+        {
+            solver_print_line(out, label, r ? &result : NULL);
+            fputc('\0', out);
+            fclose(out);
+        }
+    }
+
+    (void) write_all(fd, line, strlen(line));
+}
+
+static int
+read_request(int fd, buffer_t* buf)
+{
+    buf->used = 0U;
+
+    for (;;)
+    {
+        if (buf->used >= buf->size)
+        {
+            if (buf->size >= MAX_INPUT_SIZE)
+                return 0;
+            size_t size = buf->size * 2U;
+            char* data = realloc(buf->data, size);
+            if (data == NULL)
+                return 0;
+            buf->data = data;
+            buf->size = size;
+        }
+
+        ssize_t n = read(fd, &buf->data[buf->used], buf->size - buf->used);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return 0;
+        }
+        if (n == 0)
+            return 1; /* client finished sending */
+        buf->used += (size_t) n;
+    }
+}
+
+static int
+write_all(int fd, const char* data, size_t len)
+{
+    while (len > 0U)
+    {
+        ssize_t n = write(fd, data, len);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return 0;
+        }
+        data += n;
+        len -= (size_t) n;
+    }
+
+    return 1;
+}
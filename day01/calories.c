@@ -0,0 +1,362 @@
+/*
+ * Day 1 - module to sum up the calories of groups and keep the top groups.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "calories.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#define SCAN_WINDOW (64U) /* bytes classified at once */
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define SWAR_DIGITS (8U)  /* numbers up to this length are converted at once */
+#else
+#define SWAR_DIGITS (0U)
+#endif
+
+static void top_sift_down(top_t* t, size_t i);
+static void end_group(scan_t* s, top_t* t);
+static uint64_t classify(const char* p, uint64_t* invalid);
+static int parse_swar(const char* p, size_t len, size_t avail, unsigned long long* number);
+static int parse_digits(const char* p, size_t len, unsigned long long* number);
+
+int top_init(top_t* t, size_t n)
+{
+    assert(n > 0U);
+
+    t->heap = malloc(n * sizeof(unsigned long long));
+    if (t->heap == NULL)
+        return 0;
+    t->used = 0U;
+    t->size = n;
+
+    return 1;
+}
+
+void top_reset(top_t* t)
+{
+    t->used = 0U;
+}
+
+void top_add(top_t* t, unsigned long long sum)
+{
+    if (t->used < t->size)
+    {
+        /* sift up */
+        size_t i = t->used++;
+        while ((i > 0U) && (t->heap[(i - 1U) / 2U] > sum))
+        {
+            t->heap[i] = t->heap[(i - 1U) / 2U];
+            i = (i - 1U) / 2U;
+        }
+        t->heap[i] = sum;
+    }
+    else if (sum > t->heap[0])
+    {
+        t->heap[0] = sum;
+        top_sift_down(t, 0U);
+    }
+}
+
+void top_merge(top_t* dst, const top_t* src)
+{
+    for (size_t i = 0U; i < src->used; i++)
+        top_add(dst, src->heap[i]);
+}
+
+unsigned long long top_max(const top_t* t)
+{
+    assert(t->used > 0U);
+
+    /* the largest sum is one of the leaves */
+    unsigned long long max = t->heap[t->used / 2U];
+    for (size_t i = (t->used / 2U) + 1U; i < t->used; i++)
+    {
+        if (t->heap[i] > max)
+            max = t->heap[i];
+    }
+
+    return max;
+}
+
+unsigned long long top_sum(const top_t* t)
+{
+    unsigned long long sum = 0U;
+    for (size_t i = 0U; i < t->used; i++)
+        sum += t->heap[i];
+
+    return sum;
+}
+
+void top_free(top_t* t)
+{
+    free(t->heap);
+    t->heap = NULL;
+    t->used = 0U;
+    t->size = 0U;
+}
+
+void scan_init(scan_t* s)
+{
+    s->group = 0U;
+    s->number = 0U;
+    s->in_group = 0;
+    s->in_number = 0;
+    s->elves = 0U;
+    s->line = 1U;
+}
+
+int scan_block(scan_t* s, top_t* t, const char* text, size_t n)
+{
+    size_t start = 0U; /* beginning of the current line */
+
+    /* a number continued from the previous block */
+    if (s->in_number)
+    {
+        const char* eol = memchr(text, '\n', n);
+        if (eol == NULL)
+            return scan_block_scalar(s, t, text, n);
+        start = (size_t)(eol - text) + 1U;
+        if (!scan_block_scalar(s, t, text, start))
+            return 0;
+    }
+
+    /* find all line ends of a window at once, then convert line by line,
+     * the state is kept in locals as top_add() could alias it otherwise
+     */
+    unsigned long long group = s->group;
+    int in_group = s->in_group;
+    size_t elves = s->elves;
+    size_t line = s->line;
+    size_t i = start & ~(size_t)(SCAN_WINDOW - 1U);
+    for (; (i + SCAN_WINDOW) <= n; i += SCAN_WINDOW)
+    {
+        uint64_t invalid;
+        uint64_t eols = classify(&text[i], &invalid);
+        if (i < start)
+        {
+            eols &= ~(uint64_t) 0U << (start - i);
+            invalid &= ~(uint64_t) 0U << (start - i);
+        }
+        if (invalid != 0U) /* let the scalar loop find the line */
+            break;
+
+        while (eols != 0U)
+        {
+#if defined(__GNUC__)
+            size_t eol = i + (size_t) __builtin_ctzll(eols);
+#else
+            size_t eol = i;
+            for (uint64_t m = eols; (m & 1U) == 0U; m >>= 1)
+                eol++;
+#endif
+            const char* p = &text[start];
+            size_t len = eol - start;
+            if ((len > 0U) && (p[len - 1U] == '\r'))
+                len--;
+
+            unsigned long long number;
+            if (   ((len > 0U) && parse_swar(p, len, n - start, &number))
+                || parse_digits(p, len, &number))
+            {
+                group += number;
+                in_group = 1;
+            }
+            else if (in_group) /* empty line */
+            {
+                top_add(t, group);
+                elves++;
+                group = 0U;
+                in_group = 0;
+            }
+            line++;
+            start = eol + 1U;
+            eols &= eols - 1U;
+        }
+    }
+    s->group = group;
+    s->in_group = in_group;
+    s->elves = elves;
+    s->line = line;
+
+    /* lines of the last partial window or from an invalid character on */
+    return scan_block_scalar(s, t, &text[start], n - start);
+}
+
+int scan_block_scalar(scan_t* s, top_t* t, const char* text, size_t n)
+{
+    for (size_t i = 0U; i < n; i++)
+    {
+        char c = text[i];
+        if ((c >= '0') && (c <= '9'))
+        {
+            s->number = (s->number * 10U) + (unsigned long long)(c - '0');
+            s->in_number = 1;
+        }
+        else if (c == '\n')
+        {
+            if (s->in_number)
+            {
+                s->group += s->number;
+                s->in_group = 1;
+                s->number = 0U;
+                s->in_number = 0;
+            }
+            else /* empty line */
+            {
+                end_group(s, t);
+            }
+            s->line++;
+        }
+        else if (c != '\r')
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void scan_finish(scan_t* s, top_t* t)
+{
+    if (s->in_number) /* last line without EOL */
+    {
+        s->group += s->number;
+        s->in_group = 1;
+        s->number = 0U;
+        s->in_number = 0;
+    }
+    end_group(s, t);
+}
+
+static void top_sift_down(top_t* t, size_t i)
+{
+    unsigned long long v = t->heap[i];
+    for (;;)
+    {
+        size_t child = (2U * i) + 1U;
+        if (child >= t->used)
+            break;
+        if (((child + 1U) < t->used) && (t->heap[child + 1U] < t->heap[child]))
+            child++;
+        if (t->heap[child] >= v)
+            break;
+        t->heap[i] = t->heap[child];
+        i = child;
+    }
+    t->heap[i] = v;
+}
+
+static void end_group(scan_t* s, top_t* t)
+{
+    if (s->in_group)
+    {
+        top_add(t, s->group);
+        s->elves++;
+    }
+    s->group = 0U;
+    s->in_group = 0;
+}
+
+/* mask of line ends within the next 64 bytes, invalid bytes in second mask */
+static uint64_t classify(const char* p, uint64_t* invalid)
+{
+    uint64_t eols = 0U;
+    uint64_t valid = 0U;
+
+#if defined(__AVX2__)
+    for (unsigned int k = 0U; k < SCAN_WINDOW; k += 32U)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) &p[k]);
+        __m256i nl = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+        __m256i cr = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'));
+        __m256i d = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+        __m256i digit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+        __m256i ok = _mm256_or_si256(_mm256_or_si256(nl, cr), digit);
+        eols |= (uint64_t)(uint32_t) _mm256_movemask_epi8(nl) << k;
+        valid |= (uint64_t)(uint32_t) _mm256_movemask_epi8(ok) << k;
+    }
+#elif defined(__SSE2__)
+    for (unsigned int k = 0U; k < SCAN_WINDOW; k += 16U)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &p[k]);
+        __m128i nl = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+        __m128i cr = _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'));
+        __m128i d = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+        __m128i digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+        __m128i ok = _mm_or_si128(_mm_or_si128(nl, cr), digit);
+        eols |= (uint64_t)(uint32_t) _mm_movemask_epi8(nl) << k;
+        valid |= (uint64_t)(uint32_t) _mm_movemask_epi8(ok) << k;
+    }
+#else
+    for (unsigned int k = 0U; k < SCAN_WINDOW; k++)
+    {
+        char c = p[k];
+        if (c == '\n')
+            eols |= (uint64_t) 1U << k;
+        if ((c == '\n') || (c == '\r') || ((c >= '0') && (c <= '9')))
+            valid |= (uint64_t) 1U << k;
+    }
+#endif
+
+    *invalid = ~valid;
+
+    return eols;
+}
+
+/* convert up to 8 digits at once, fails on a carriage return inside */
+static int parse_swar(const char* p, size_t len, size_t avail, unsigned long long* number)
+{
+    if (len > SWAR_DIGITS)
+        return 0;
+
+    /* load the digits into a word, first digit in the lowest byte */
+    uint64_t v = 0U;
+    if (avail >= 8U)
+        memcpy(&v, p, 8U); /* a single load */
+    else
+        memcpy(&v, p, len);
+    if (len < 8U)
+        v &= ((uint64_t) 1U << (8U * len)) - 1U;
+
+    /* https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord */
+    uint64_t x = v ^ 0x0D0D0D0D0D0D0D0DU;
+    if (((x - 0x0101010101010101U) & ~x & 0x8080808080808080U) != 0U)
+        return 0;
+
+    /* leading zeros, then sum up pairs, quadruples and octets of digits */
+    v = (v & 0x0F0F0F0F0F0F0F0FU) << (8U * (8U - len));
+    v = ((v * 2561U) >> 8) & 0x00FF00FF00FF00FFU;
+    v = ((v * 6553601U) >> 16) & 0x0000FFFF0000FFFFU;
+    *number = (v * 42949672960001U) >> 32;
+
+    return 1;
+}
+
+/* convert digits of a line known to be valid, fails if there are none */
+static int parse_digits(const char* p, size_t len, unsigned long long* number)
+{
+    int digits = 0;
+    *number = 0U;
+    for (size_t i = 0U; i < len; i++)
+    {
+        if (p[i] != '\r')
+        {
+            *number = (*number * 10U) + (unsigned long long)(p[i] - '0');
+            digits = 1;
+        }
+    }
+
+    return digits;
+}
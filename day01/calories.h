@@ -0,0 +1,70 @@
+/*
+ * Day 1 - module to sum up the calories of groups and keep the top groups.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef CALORIES_H_
+#define CALORIES_H_
+
+#include <stdlib.h>
+
+/* min-heap of the largest group sums seen so far, heap[0] is the smallest */
+typedef struct
+{
+    unsigned long long* heap;
+    size_t used;
+    size_t size;    /* number of sums to keep */
+} top_t;
+
+/* state of scanning text block by block, a block may end anywhere */
+typedef struct
+{
+    unsigned long long group;   /* sum of the current group */
+    unsigned long long number;  /* current number */
+    int in_group;               /* at least one number in current group */
+    int in_number;
+    size_t elves;               /* number of completed groups */
+    size_t line;                /* number of current line, starting at 1 */
+} scan_t;
+
+/* allocate heap for the n largest sums */
+int top_init(top_t* t, size_t n);
+
+/* remove all sums, keeps allocated memory */
+void top_reset(top_t* t);
+
+/* add a group sum, kept only if it is one of the largest */
+void top_add(top_t* t, unsigned long long sum);
+
+/* add all sums of src to dst */
+void top_merge(top_t* dst, const top_t* src);
+
+/* largest sum, heap must not be empty */
+unsigned long long top_max(const top_t* t);
+
+/* sum of all kept sums */
+unsigned long long top_sum(const top_t* t);
+
+void top_free(top_t* t);
+
+/* start scanning at the beginning of a group */
+void scan_init(scan_t* s);
+
+/*
+ * Scan next block of text, returns 0 on unexpected characters. Line ends of
+ * 64 bytes are found at once with SSE2 or AVX2 if available, numbers of up to
+ * 8 digits are converted within a 64 bit word.
+ */
+int scan_block(scan_t* s, top_t* t, const char* text, size_t n);
+
+/* same as scan_block() byte by byte, as reference */
+int scan_block_scalar(scan_t* s, top_t* t, const char* text, size_t n);
+
+/* complete the last group at the end of the text */
+void scan_finish(scan_t* s, top_t* t);
+
+#endif /* CALORIES_H_ */
@@ -0,0 +1,126 @@
+/*
+ * Solver for advent of code 2022 day 1.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day01.h"
+
+#include "calories.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BLOCK_SIZE (65536U)
+
+typedef struct
+{
+    top_t top;
+    char* block;
+} state_t;
+
+static size_t top_n = DAY01_TOP_N_DEFAULT;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+
+const solver_t day01_solver =
+{
+    .name = "day01",
+    .title = "Day 1: Calorie Counting",
+    .part =
+    {
+        "Most calories carried by an elf",
+        "Calories carried by top elves"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+int day01_set_top_n(size_t n)
+{
+    if ((n == 0U) || (n > DAY01_TOP_N_MAX))
+        return 0;
+
+    top_n = n;
+
+    return 1;
+}
+
+size_t day01_top_n(void)
+{
+    return top_n;
+}
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->block = malloc(BLOCK_SIZE);
+    if ((s->block == NULL) || !top_init(&s->top, top_n))
+    {
+        free(s->block);
+        free(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    scan_t scan;
+
+    top_reset(&s->top);
+    scan_init(&scan);
+
+    /* only the sum of the current group and the top groups are kept */
+    size_t n;
+    while ((n = fread(s->block, 1U, BLOCK_SIZE, fp)) > 0U)
+    {
+        if (!scan_block(&scan, &s->top, s->block, n))
+        {
+            fprintf(stderr, "Unexpected data in line %llu!", (unsigned long long) scan.line);
+            return 0;
+        }
+    }
+    scan_finish(&scan, &s->top);
+
+    return day01_answer(&s->top, scan.elves, log, result);
+}
+
+int day01_answer(const top_t* top, size_t elves, FILE* log, solver_result_t* result)
+{
+    solver_log(log, "Entries of %llu elves found.\n", (unsigned long long) elves);
+    if (elves < top->size)
+    {
+        fprintf(stderr, "Not enough elves!");
+        return 0;
+    }
+
+    /* part 1 */
+    solver_answer(result, 1U, "%llu", top_max(top));
+
+    /* part 2 */
+    solver_log(log, "Sum of the top %llu elves.\n", (unsigned long long) top->size);
+    solver_answer(result, 2U, "%llu", top_sum(top));
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    top_free(&s->top);
+    free(s->block);
+    free(s);
+}
@@ -0,0 +1,55 @@
+/*
+ * Solver for advent of code 2022 day 1.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY01_H_
+#define DAY01_H_
+
+#include "calories.h"
+#include "solver.h"
+
+#define DAY01_TOP_N_DEFAULT (3U)       /* elves summed up for part 2 */
+#define DAY01_TOP_N_MAX     (1000000U)
+
+extern const solver_t day01_solver;
+
+/**
+ * \brief Set the number of top elves summed up for part 2.
+ *
+ * Applies to states created afterwards, so it must be set before solving.
+ *
+ * \param[in] n Number of elves, 1 to DAY01_TOP_N_MAX.
+ *
+ * \return int
+ * \retval 0 Invalid number.
+ * \retval 1 Success.
+ */
+int day01_set_top_n(size_t n);
+
+/**
+ * \brief Get the number of top elves summed up for part 2.
+ *
+ * \return size_t Number of elves.
+ */
+size_t day01_top_n(void);
+
+/**
+ * \brief Store both answers from the top groups of an input.
+ *
+ * \param[in]  top    Largest group sums, as many as selected for part 2.
+ * \param[in]  elves  Number of groups of the input.
+ * \param[in]  log    Stream for verbose output, may be NULL.
+ * \param[out] result Answers.
+ *
+ * \return int
+ * \retval 0 Failure, less groups than selected for part 2.
+ * \retval 1 Success.
+ */
+int day01_answer(const top_t* top, size_t elves, FILE* log, solver_result_t* result);
+
+#endif /* DAY01_H_ */
@@ -7,101 +7,324 @@
  * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
  */
 
-#include "compare.h"
+/*
+ * Besides the options of all days, this program accepts:
+ *
+ *   -n N  number of top elves summed up for part 2
+ *   -p N  solve each file memory mapped with N threads
+ *   -s N  scaling benchmark of each file with 1 to N threads
+ *   -k    benchmark of the scanner against the byte by byte loop
+ *   -g MB file  generate an input of the given size in megabytes
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "day01.h"
+#include "parallel.h"
 
 #include <stdio.h>
-#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_REPETITIONS (5U)
+#define GEN_BUFFER_SIZE   (65536U)
+#define GEN_MAX_ITEMS     (15U)     /* lines per group */
+#define GEN_MAX_CALORIES  (99999U)
 
-#define MAX_LINE_SIZE   (32U)
-#define DATA_CHUNK_SIZE (2U)
+static int run_parallel(int files, char* names[], unsigned int threads);
+static int run_scaling(int files, char* names[], unsigned int threads);
+static int run_kernels(int files, char* names[]);
+static int bench_kernel(const mapping_t* m,
+                        int (*scan)(scan_t*, top_t*, const char*, size_t),
+                        double* best, unsigned long long* answer);
+static int generate(const char* name, unsigned long megabytes);
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1);
 
 int main(int argc, char *argv[])
 {
-    printf("Advent of Code 2022 - Day 1: Calorie Counting\n\n");
+    unsigned int parallel = 0U;
+    unsigned int scaling = 0U;
+    int kernels = 0;
 
-    if (argc != 2)
+    /* day specific options are handled here, other arguments are passed on */
+    int args = 1;
+    for (int i = 1; i < argc; i++)
     {
-        fprintf(stderr, "Please provide data record file name.");
-        exit(EXIT_FAILURE);
+        if (strcmp(argv[i], "-n") == 0)
+        {
+            unsigned long n;
+            if (   ((i + 1) >= argc)
+                || (sscanf(argv[i + 1], "%lu", &n) != 1)
+                || !day01_set_top_n((size_t) n))
+            {
+                fprintf(stderr, "Invalid number of elves!\n");
+                return EXIT_FAILURE;
+            }
+            i++;
+        }
+        else if ((strcmp(argv[i], "-p") == 0) || (strcmp(argv[i], "-s") == 0))
+        {
+            unsigned int threads;
+            if (   ((i + 1) >= argc)
+                || (sscanf(argv[i + 1], "%u", &threads) != 1)
+                || (threads == 0U)
+                || (threads > PARALLEL_MAX_THREADS))
+            {
+                fprintf(stderr, "Invalid number of threads!\n");
+                return EXIT_FAILURE;
+            }
+            if (argv[i][1] == 'p')
+                parallel = threads;
+            else
+                scaling = threads;
+            i++;
+        }
+        else if (strcmp(argv[i], "-k") == 0)
+        {
+            kernels = 1;
+        }
+        else if (strcmp(argv[i], "-g") == 0)
+        {
+            unsigned long megabytes;
+            if (   ((i + 2) >= argc)
+                || (sscanf(argv[i + 1], "%lu", &megabytes) != 1)
+                || (megabytes == 0U))
+            {
+                fprintf(stderr, "Invalid size or file name!\n");
+                return EXIT_FAILURE;
+            }
+            return generate(argv[i + 2], megabytes);
+        }
+        else
+        {
+            argv[args++] = argv[i];
+        }
     }
+    argv[args] = NULL;
 
-    FILE* fp = fopen(argv[1], "r");
+    if (kernels)
+        return run_kernels(args - 1, &argv[1]);
+    if (scaling > 0U)
+        return run_scaling(args - 1, &argv[1], scaling);
+    if (parallel > 0U)
+        return run_parallel(args - 1, &argv[1], parallel);
 
-    if (!fp)
-    {
-        fprintf(stderr, "Could not open file!");
-        exit(EXIT_FAILURE);
-    }
+    return solver_main(&day01_solver, args, argv);
+}
+
+static int run_parallel(int files, char* names[], unsigned int threads)
+{
+    int r = EXIT_SUCCESS;
 
-    char line_buf[MAX_LINE_SIZE];
-    size_t elf = 0U;
-    size_t elves_max = DATA_CHUNK_SIZE;
-    int* calories_per_elf = malloc(elves_max * sizeof(int));
-    if (calories_per_elf == NULL)
+    for (int i = 0; i < files; i++)
     {
-        fprintf(stderr, "Not enough memory!");
-        exit(EXIT_FAILURE);
+        mapping_t m;
+        solver_result_t result;
+        int ok = mapping_open(&m, names[i]);
+        if (!ok)
+            fprintf(stderr, "Could not open file %s!\n", names[i]);
+        else
+            ok = parallel_solve(&m, threads, &result);
+        mapping_close(&m);
+
+        solver_print_line(stdout, names[i], ok ? &result : NULL);
+        if (!ok)
+            r = EXIT_FAILURE;
     }
 
-    calories_per_elf[elf] = 0;
-    int line = 1;
-    while (fgets(line_buf, MAX_LINE_SIZE, fp))
+    return r;
+}
+
+static int run_scaling(int files, char* names[], unsigned int threads)
+{
+    for (int i = 0; i < files; i++)
     {
-        if (line_buf[0] == '\n')
+        mapping_t m;
+        if (!mapping_open(&m, names[i]))
+        {
+            fprintf(stderr, "Could not open file %s!\n", names[i]);
+            return EXIT_FAILURE;
+        }
+
+        printf("%s: %llu bytes\n", names[i], (unsigned long long) m.size);
+        printf("threads     time [ms]      GB/s   speedup\n");
+
+        solver_result_t first;
+        double base = 0.0;
+        for (unsigned int t = 1U; t <= threads; t++)
         {
-            elf++;
-            if (elf >= elves_max)
+            /* the fastest run is least disturbed by other processes */
+            double best = 0.0;
+            solver_result_t result;
+            for (unsigned int rep = 0U; rep < BENCH_REPETITIONS; rep++)
             {
-                elves_max += DATA_CHUNK_SIZE;
-                calories_per_elf = realloc(calories_per_elf, elves_max * sizeof(int));
-                if (NULL == calories_per_elf)
+                struct timespec t0, t1;
+                clock_gettime(CLOCK_MONOTONIC, &t0);
+                int ok = parallel_solve(&m, t, &result);
+                clock_gettime(CLOCK_MONOTONIC, &t1);
+                if (!ok)
                 {
-                    fprintf(stderr, "Not enough memory!");
-                    exit(EXIT_FAILURE);
+                    mapping_close(&m);
+                    return EXIT_FAILURE;
                 }
+                double s = elapsed_s(&t0, &t1);
+                if ((rep == 0U) || (s < best))
+                    best = s;
             }
-            calories_per_elf[elf] = 0;
-        }
-        else
-        {
-            int calories = 0;
-            if (sscanf(line_buf, "%d", &calories) == 1)
+
+            if (t == 1U)
             {
-                calories_per_elf[elf] += calories;
+                first = result;
+                base = best;
             }
-            else
+            else if (   (strcmp(first.answer[0], result.answer[0]) != 0)
+                     || (strcmp(first.answer[1], result.answer[1]) != 0))
             {
-                fprintf(stderr, "Unexpected data in line %d!", line);
-                exit(EXIT_FAILURE);
+                fprintf(stderr, "Answers differ with %u threads!\n", t);
+                mapping_close(&m);
+                return EXIT_FAILURE;
             }
+
+            printf("%7u %13.3f %9.3f %9.2f\n",
+                   t, best * 1e3, ((double) m.size / best) / 1e9, base / best);
         }
-        line++;
+        mapping_close(&m);
     }
 
-    fclose(fp);
+    return EXIT_SUCCESS;
+}
 
-    size_t elves = elf + 1U;
-    printf("Entries of %lld elves found.\n", elves);
+static int run_kernels(int files, char* names[])
+{
+    for (int i = 0; i < files; i++)
+    {
+        mapping_t m;
+        if (!mapping_open(&m, names[i]))
+        {
+            fprintf(stderr, "Could not open file %s!\n", names[i]);
+            return EXIT_FAILURE;
+        }
 
-    /* part 1 */
-    int calories_max = calories_per_elf[0];
-    for (size_t elf = 1U; elf < elves; elf++)
+        double scalar_s;
+        double block_s;
+        unsigned long long scalar_sum;
+        unsigned long long block_sum;
+        int ok =    bench_kernel(&m, scan_block_scalar, &scalar_s, &scalar_sum)
+                 && bench_kernel(&m, scan_block, &block_s, &block_sum);
+        if (ok && (scalar_sum != block_sum))
+        {
+            fprintf(stderr, "Answers of the scanners differ!\n");
+            ok = 0;
+        }
+        if (ok)
+        {
+            printf("%s: %llu bytes\n", names[i], (unsigned long long) m.size);
+            printf("byte by byte %9.3f GB/s\n", ((double) m.size / scalar_s) / 1e9);
+            printf("scanner      %9.3f GB/s\n", ((double) m.size / block_s) / 1e9);
+        }
+        mapping_close(&m);
+        if (!ok)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* scan the whole mapping at once, the fastest run is kept */
+static int bench_kernel(const mapping_t* m,
+                        int (*scan)(scan_t*, top_t*, const char*, size_t),
+                        double* best, unsigned long long* answer)
+{
+    top_t top;
+    if (!top_init(&top, day01_top_n()))
     {
-        if (calories_max < calories_per_elf[elf])
+        fprintf(stderr, "Not enough memory!\n");
+        return 0;
+    }
+
+    for (unsigned int rep = 0U; rep < BENCH_REPETITIONS; rep++)
+    {
+        scan_t s;
+        struct timespec t0, t1;
+        top_reset(&top);
+        scan_init(&s);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int ok = scan(&s, &top, m->text, m->size);
+        if (ok)
+            scan_finish(&s, &top);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (!ok || (top.used == 0U))
         {
-            calories_max = calories_per_elf[elf];
+            fprintf(stderr, "Unexpected data in line %llu!\n", (unsigned long long) s.line);
+            top_free(&top);
+            return 0;
         }
+        double t = elapsed_s(&t0, &t1);
+        if ((rep == 0U) || (t < *best))
+            *best = t;
+    }
+    *answer = top_sum(&top);
+    top_free(&top);
+
+    return 1;
+}
+
+/* groups of random calories, reproducible by a fixed seed */
+static int generate(const char* name, unsigned long megabytes)
+{
+    FILE* fp = fopen(name, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return EXIT_FAILURE;
     }
-    printf("Part 1: Most calories carried by an elf = %d\n", calories_max);
 
-    /* part 2 */
-    qsort(calories_per_elf, elves, sizeof(int), compare_ints);
-    int calories_top_three = 0;
-    for (size_t elf = 1U; elf <= 3U; elf++)
+    static char buf[GEN_BUFFER_SIZE];
+    unsigned long long size = (unsigned long long) megabytes * 1000000U;
+    unsigned long long written = 0U;
+    unsigned long long rng = 88172645463325252U;
+    size_t used = 0U;
+    unsigned int items = 0U;
+    while (written < size)
+    {
+        /* xorshift64, https://en.wikipedia.org/wiki/Xorshift */
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+
+        if (items == 0U)
+        {
+            if (written > 0U)
+            {
+                buf[used++] = '\n';
+                written++;
+            }
+            items = 1U + (unsigned int)(rng % GEN_MAX_ITEMS);
+        }
+        int n = sprintf(&buf[used], "%llu\n", 1U + ((rng >> 16) % GEN_MAX_CALORIES));
+        used += (size_t) n;
+        written += (unsigned long long) n;
+        items--;
+
+        if ((used + 32U) > GEN_BUFFER_SIZE)
+        {
+            if (fwrite(buf, 1U, used, fp) != used)
+                break;
+            used = 0U;
+        }
+    }
+    int ok = (fwrite(buf, 1U, used, fp) == used);
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok)
     {
-        calories_top_three += calories_per_elf[elves - elf];
+        fprintf(stderr, "Could not write file %s!\n", name);
+        return EXIT_FAILURE;
     }
-    printf("Part 2: Calories carried by top-three elves = %d\n", calories_top_three);
 
     return EXIT_SUCCESS;
 }
+
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1)
+{
+    return (double)(t1->tv_sec - t0->tv_sec) + ((double)(t1->tv_nsec - t0->tv_nsec) / 1e9);
+}
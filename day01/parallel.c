@@ -0,0 +1,139 @@
+/*
+ * Day 1 - module to solve a memory mapped input with several threads.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "parallel.h"
+
+#include "day01.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct
+{
+    const char* text;
+    size_t size;
+    top_t top;      /* top groups of this chunk */
+    scan_t scan;
+    int ok;
+} chunk_t;
+
+static size_t find_boundary(const char* text, size_t size, size_t from);
+static void* chunk_worker(void* arg);
+
+int parallel_solve(const mapping_t* m, unsigned int threads, solver_result_t* result)
+{
+    assert((threads > 0U) && (threads <= PARALLEL_MAX_THREADS));
+
+    chunk_t chunks[PARALLEL_MAX_THREADS];
+    pthread_t workers[PARALLEL_MAX_THREADS];
+    size_t top_n = day01_top_n();
+
+    /* groups never span two chunks, so no sums need to be stitched together */
+    size_t begin = 0U;
+    for (unsigned int i = 0U; i < threads; i++)
+    {
+        size_t end = m->size;
+        if ((i + 1U) < threads)
+            end = find_boundary(m->text, m->size, (m->size / threads) * (i + 1U));
+        if (end < begin) /* a large group covers the whole nominal chunk */
+            end = begin;
+        chunks[i].text = m->text + begin;
+        chunks[i].size = end - begin;
+        chunks[i].ok = 0;
+        if (!top_init(&chunks[i].top, top_n))
+        {
+            while (i-- > 0U)
+                top_free(&chunks[i].top);
+            fprintf(stderr, "Not enough memory!\n");
+            return 0;
+        }
+        begin = end;
+    }
+
+    /* the calling thread takes the first chunk */
+    unsigned int started = 1U;
+    for (; started < threads; started++)
+    {
+        if (pthread_create(&workers[started], NULL, chunk_worker, &chunks[started]) != 0)
+            break;
+    }
+    chunk_worker(&chunks[0]);
+    for (unsigned int i = started; i < threads; i++) /* not started, e.g. no resources */
+        chunk_worker(&chunks[i]);
+    for (unsigned int i = 1U; i < started; i++)
+        pthread_join(workers[i], NULL);
+
+    top_t total;
+    int ok = top_init(&total, top_n);
+    size_t elves = 0U;
+    for (unsigned int i = 0U; i < threads; i++)
+    {
+        if (!chunks[i].ok)
+        {
+            if (ok)
+                fprintf(stderr, "Unexpected data in line %llu of chunk %u!",
+                        (unsigned long long) chunks[i].scan.line, i + 1U);
+            ok = 0;
+        }
+        else if (ok)
+        {
+            top_merge(&total, &chunks[i].top);
+            elves += chunks[i].scan.elves;
+        }
+        top_free(&chunks[i].top);
+    }
+
+    if (ok)
+        ok = day01_answer(&total, elves, NULL, result);
+    top_free(&total);
+
+    return ok;
+}
+
+/* get start of the first group after the first empty line at or after from */
+static size_t find_boundary(const char* text, size_t size, size_t from)
+{
+    size_t i = from;
+
+    /* continue at the beginning of a line */
+    while ((i > 0U) && (i < size) && (text[i - 1U] != '\n'))
+        i++;
+
+    while (i < size)
+    {
+        size_t j = i;
+        if ((j < size) && (text[j] == '\r'))
+            j++;
+        if ((j < size) && (text[j] == '\n'))
+            return j + 1U;
+
+        const char* eol = memchr(&text[i], '\n', size - i);
+        if (eol == NULL)
+            break;
+        i = (size_t)(eol - text) + 1U;
+    }
+
+    return size;
+}
+
+static void* chunk_worker(void* arg)
+{
+    chunk_t* c = arg;
+
+    scan_init(&c->scan);
+    c->ok = scan_block(&c->scan, &c->top, c->text, c->size);
+    if (c->ok)
+        scan_finish(&c->scan, &c->top);
+
+    return NULL;
+}
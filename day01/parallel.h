@@ -0,0 +1,27 @@
+/*
+ * Day 1 - module to solve a memory mapped input with several threads.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include "mapping.h"
+#include "solver.h"
+
+#include <stdlib.h>
+
+#define PARALLEL_MAX_THREADS (64U)
+
+/*
+ * Split the text into one chunk per thread at group boundaries, sum up the
+ * groups of each chunk with its own top groups and merge them. Both answers
+ * are stored in result, returns 0 on invalid input or lack of resources.
+ */
+int parallel_solve(const mapping_t* m, unsigned int threads, solver_result_t* result);
+
+#endif /* PARALLEL_H_ */
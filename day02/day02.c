@@ -0,0 +1,112 @@
+/*
+ * Solver for advent of code 2022 day 2.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day02.h"
+
+#include "rounds.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_SIZE (65536U)
+
+typedef struct
+{
+    char* block;
+} state_t;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+
+const solver_t day02_solver =
+{
+    .name = "day02",
+    .title = "Day 2: Rock Paper Scissors",
+    .part =
+    {
+        "score",
+        "score"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->block = malloc(BLOCK_SIZE);
+    if (s->block == NULL)
+    {
+        free(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    scores_t scores;
+
+    (void) log;
+
+    scores_init(&scores);
+
+    /* score all complete lines of a block, the rest is moved to the front */
+    size_t used = 0U;
+    size_t n;
+    while ((n = fread(&s->block[used], 1U, BLOCK_SIZE - used, fp)) > 0U)
+    {
+        used += n;
+        const char* eol = NULL;
+        for (size_t i = used; i > 0U; i--)
+        {
+            if (s->block[i - 1U] == '\n')
+            {
+                eol = &s->block[i - 1U];
+                break;
+            }
+        }
+        if (eol == NULL)
+        {
+            if (used < BLOCK_SIZE)
+                continue;
+            fprintf(stderr, "Unexpected data in line %llu!", (unsigned long long) scores.line);
+            return 0;
+        }
+
+        size_t lines = (size_t)(eol - s->block) + 1U;
+        if (!rounds_score(&scores, s->block, lines))
+            return 0;
+        used -= lines;
+        memmove(s->block, &s->block[lines], used);
+    }
+    if ((used > 0U) && !rounds_score(&scores, s->block, used)) /* no line end */
+        return 0;
+
+    solver_answer(result, 1U, "%llu", scores.part1);
+    solver_answer(result, 2U, "%llu", scores.part2);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    free(s->block);
+    free(s);
+}
@@ -0,0 +1,17 @@
+/*
+ * Solver for advent of code 2022 day 2.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY02_H_
+#define DAY02_H_
+
+#include "solver.h"
+
+extern const solver_t day02_solver;
+
+#endif /* DAY02_H_ */
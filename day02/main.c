@@ -7,216 +7,242 @@
  * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
  */
 
-#include <stdio.h>
-#include <stdlib.h>
+/*
+ * Besides the options of all days, this program accepts:
+ *
+ *   -k             benchmark of scoring each file from memory, table vs. AVX2
+ *   -p N           count the rounds of each file memory mapped with N threads
+ *   -g rounds file generate an input with the given number of rounds
+ */
 
-#define MAX_LINE_SIZE (32U)
+#define _POSIX_C_SOURCE 200809L
 
-#define SCORE_LOSS (0)
-#define SCORE_DRAW (3)
-#define SCORE_WIN  (6)
+#include "day02.h"
+#include "parallel.h"
+#include "rounds.h"
 
-#define SCORE_ROCK     (1)
-#define SCORE_PAPER    (2)
-#define SCORE_SCISSORS (3)
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_REPETITIONS (5U)
+#define GEN_BUFFER_SIZE   (65536U)
+#define LINE_SIZE         (4U)      /* "A X\n" */
+
+static int run_kernels(int files, char* names[]);
+static int run_parallel(int files, char* names[], unsigned int threads);
+static int bench_kernel(const char* data, size_t size,
+                        int (*score)(scores_t*, const char*, size_t),
+                        scores_t* s, double* best);
+static int read_file(const char* name, char** data, size_t* size);
+static int generate(const char* name, unsigned long long rounds);
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1);
 
-typedef enum
+int main(int argc, char *argv[])
 {
-    R = 0,  /* rock */
-    P,      /* paper */
-    S,      /* scissors */
-    NUM_CHOICE_
-} choice_t;
+    int kernels = 0;
+    unsigned int parallel = 0U;
 
-typedef enum
-{
-    X = 0,
-    Y,
-    Z,
-    NUM_MY_CHOICE_
-} choice_mine_t;
-
-/* part 1: get battle score by choices */
-const int score_battle_p1[NUM_CHOICE_][NUM_CHOICE_] =
-{
-    [R] =
-    {
-        [R] = SCORE_DRAW,  /* rock vs. rock */
-        [P] = SCORE_WIN,   /* rock vs. paper */
-        [S] = SCORE_LOSS   /* rock vs. scissors */
-    },
-    [P] =
+    /* day specific options are handled here, other arguments are passed on */
+    int args = 1;
+    for (int i = 1; i < argc; i++)
     {
-        [R] = SCORE_LOSS,  /* paper vs. rock */
-        [P] = SCORE_DRAW,  /* paper vs. paper */
-        [S] = SCORE_WIN,   /* paper vs. scissors */
-    },
-    [S] =
-    {
-        [R] = SCORE_WIN,   /* scissors vs. rock */
-        [P] = SCORE_LOSS,  /* scissors vs. paper */
-        [S] = SCORE_DRAW   /* scissors vs. scissors */
+        if (strcmp(argv[i], "-k") == 0)
+        {
+            kernels = 1;
+        }
+        else if (strcmp(argv[i], "-p") == 0)
+        {
+            if (   ((i + 1) >= argc)
+                || (sscanf(argv[i + 1], "%u", &parallel) != 1)
+                || (parallel == 0U)
+                || (parallel > PARALLEL_MAX_THREADS))
+            {
+                fprintf(stderr, "Invalid number of threads!\n");
+                return EXIT_FAILURE;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-g") == 0)
+        {
+            unsigned long long rounds;
+            if (   ((i + 2) >= argc)
+                || (sscanf(argv[i + 1], "%llu", &rounds) != 1)
+                || (rounds == 0U))
+            {
+                fprintf(stderr, "Invalid number of rounds or file name!\n");
+                return EXIT_FAILURE;
+            }
+            return generate(argv[i + 2], rounds);
+        }
+        else
+        {
+            argv[args++] = argv[i];
+        }
     }
-};
+    argv[args] = NULL;
 
-/* part 1:get choice by tip */
-const choice_t choice_p1[NUM_CHOICE_] =
-{
-    [X] = R,
-    [Y] = P,
-    [Z] = S
-};
+    if (kernels)
+        return run_kernels(args - 1, &argv[1]);
+    if (parallel > 0U)
+        return run_parallel(args - 1, &argv[1], parallel);
 
-/* part 1/2: get choice score by choice */
-const int score_choice[NUM_CHOICE_] =
-{
-    [R] = SCORE_ROCK,
-    [P] = SCORE_PAPER,
-    [S] = SCORE_SCISSORS
-};
+    return solver_main(&day02_solver, args, argv);
+}
 
-/* part 2: get choice by goal and opponent */
-const choice_t choice_by_goal[NUM_MY_CHOICE_][NUM_CHOICE_] =
+static int run_kernels(int files, char* names[])
 {
-    [X] = /* loss */
-    {
-        [R] = S,
-        [P] = R,
-        [S] = P
-    },
-    [Y] = /* draw */
+    for (int i = 0; i < files; i++)
     {
-        [R] = R,
-        [P] = P,
-        [S] = S
-    },
-    [Z] = /* win */
-    {
-        [R] = P,
-        [P] = S,
-        [S] = R
+        char* data;
+        size_t size;
+        if (!read_file(names[i], &data, &size))
+        {
+            fprintf(stderr, "Could not read file %s!\n", names[i]);
+            return EXIT_FAILURE;
+        }
+
+        scores_t scalar;
+        scores_t vector;
+        double scalar_s;
+        double vector_s;
+        int ok =    bench_kernel(data, size, rounds_score_scalar, &scalar, &scalar_s)
+                 && bench_kernel(data, size, rounds_score, &vector, &vector_s);
+        free(data);
+        if (!ok)
+            return EXIT_FAILURE;
+        if ((scalar.part1 != vector.part1) || (scalar.part2 != vector.part2))
+        {
+            fprintf(stderr, "Scores of table and vectors differ!\n");
+            return EXIT_FAILURE;
+        }
+
+        double rounds = (double)(scalar.line - 1U);
+        printf("%s: %.0f rounds, scores %llu %llu\n", names[i], rounds, scalar.part1, scalar.part2);
+        printf("table   %9.3f GB/s %9.1f M rounds/s\n",
+               ((double) size / scalar_s) / 1e9, (rounds / scalar_s) / 1e6);
+#if defined(__AVX2__)
+        printf("vectors %9.3f GB/s %9.1f M rounds/s\n",
+               ((double) size / vector_s) / 1e9, (rounds / vector_s) / 1e6);
+#else
+        printf("vectors not built, compile with -mavx2\n");
+#endif
     }
-};
 
-/* part 2: get battle score by goal */
-const choice_t score_battle_p2[NUM_MY_CHOICE_] =
+    return EXIT_SUCCESS;
+}
+
+static int run_parallel(int files, char* names[], unsigned int threads)
 {
-    [X] = SCORE_LOSS,
-    [Y] = SCORE_DRAW,
-    [Z] = SCORE_WIN
-};
+    int r = EXIT_SUCCESS;
 
-int main(int argc, char *argv[])
+    for (int i = 0; i < files; i++)
+    {
+        mapping_t m;
+        solver_result_t result;
+        int ok = mapping_open(&m, names[i]);
+        if (!ok)
+            fprintf(stderr, "Could not open file %s!\n", names[i]);
+        else
+            ok = parallel_solve(&m, threads, &result);
+        mapping_close(&m);
+
+        solver_print_line(stdout, names[i], ok ? &result : NULL);
+        if (!ok)
+            r = EXIT_FAILURE;
+    }
+
+    return r;
+}
+
+/* score the whole data at once, the fastest run is kept */
+static int bench_kernel(const char* data, size_t size,
+                        int (*score)(scores_t*, const char*, size_t),
+                        scores_t* s, double* best)
 {
-    printf("Advent of Code 2022 - Day 2: Rock Paper Scissors\n\n");
+    for (unsigned int rep = 0U; rep < BENCH_REPETITIONS; rep++)
+    {
+        struct timespec t0, t1;
+        scores_init(s);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int ok = score(s, data, size);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (!ok)
+            return 0;
+        double t = elapsed_s(&t0, &t1);
+        if ((rep == 0U) || (t < *best))
+            *best = t;
+    }
+
+    return 1;
+}
 
-    if (argc != 2)
+static int read_file(const char* name, char** data, size_t* size)
+{
+    FILE* fp = fopen(name, "rb");
+    if (fp == NULL)
+        return 0;
+
+    int ok = 0;
+    long len;
+    if (   (fseek(fp, 0L, SEEK_END) == 0)
+        && ((len = ftell(fp)) >= 0L)
+        && (fseek(fp, 0L, SEEK_SET) == 0))
     {
-        fprintf(stderr, "Please provide data record file name.");
-        exit(EXIT_FAILURE);
+        *size = (size_t) len;
+        *data = malloc((*size > 0U) ? *size : 1U);
+        ok = (*data != NULL) && (fread(*data, 1U, *size, fp) == *size);
+        if (!ok)
+            free(*data);
     }
+    fclose(fp);
 
-    FILE* fp = fopen(argv[1], "r");
+    return ok;
+}
 
-    if (!fp)
+/* random rounds, reproducible by a fixed seed */
+static int generate(const char* name, unsigned long long rounds)
+{
+    FILE* fp = fopen(name, "wb");
+    if (fp == NULL)
     {
-        fprintf(stderr, "Could not open file!");
-        exit(EXIT_FAILURE);
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return EXIT_FAILURE;
     }
 
-    int line = 1;
-    int score_part1 = 0;
-    int score_part2 = 0;
-    char line_buf[MAX_LINE_SIZE];
-    while (fgets(line_buf, MAX_LINE_SIZE, fp))
+    static char buf[GEN_BUFFER_SIZE];
+    unsigned long long rng = 88172645463325252U;
+    size_t used = 0U;
+    int ok = 1;
+    for (unsigned long long r = 0U; ok && (r < rounds); r++)
     {
-        char opponent = '\0';
-        char me = '\0';
-        if (sscanf(line_buf, "%c %c", &opponent, &me) == 2)
-        {
-            switch (opponent)
-            {
-                case 'A': /* rock */
-                    switch(me)
-                    {
-                        case 'X':
-                            score_part1 += score_battle_p1[R][choice_p1[X]] + score_choice[X];
-                            score_part2 += score_battle_p2[X] + score_choice[choice_by_goal[X][R]];
-                            break;
-                        case 'Y':
-                            score_part1 += score_battle_p1[R][choice_p1[Y]] + score_choice[Y];
-                            score_part2 += score_battle_p2[Y] + score_choice[choice_by_goal[Y][R]];
-                            break;
-                        case 'Z':
-                            score_part1 += score_battle_p1[R][choice_p1[Z]] + score_choice[Z];
-                            score_part2 += score_battle_p2[Z] + score_choice[choice_by_goal[Z][R]];
-                            break;
-                        default:
-                            fprintf(stderr, "Invalid selection by myself %c in line %d!", me, line);
-                            exit(EXIT_FAILURE);
-                            break;
-                    }
-                    break;
-                case 'B': /* paper */
-                    switch(me)
-                    {
-                        case 'X':
-                            score_part1 += score_battle_p1[P][choice_p1[X]] + score_choice[X];
-                            score_part2 += score_battle_p2[X] + score_choice[choice_by_goal[X][P]];
-                            break;
-                        case 'Y':
-                            score_part1 += score_battle_p1[P][choice_p1[Y]] + score_choice[Y];
-                            score_part2 += score_battle_p2[Y] + score_choice[choice_by_goal[Y][P]];
-                            break;
-                        case 'Z':
-                            score_part1 += score_battle_p1[P][choice_p1[Z]] + score_choice[Z];
-                            score_part2 += score_battle_p2[Z] + score_choice[choice_by_goal[Z][P]];
-                            break;
-                        default:
-                            fprintf(stderr, "Invalid selection by myself %c in line %d!", me, line);
-                            exit(EXIT_FAILURE);
-                            break;
-                    }
-                    break;
-                case 'C': /* scissors */
-                    switch(me)
-                    {
-                        case 'X':
-                            score_part1 += score_battle_p1[S][choice_p1[X]] + score_choice[X];
-                            score_part2 += score_battle_p2[X] + score_choice[choice_by_goal[X][S]];
-                            break;
-                        case 'Y':
-                            score_part1 += score_battle_p1[S][choice_p1[Y]] + score_choice[Y];
-                            score_part2 += score_battle_p2[Y] + score_choice[choice_by_goal[Y][S]];
-                            break;
-                        case 'Z':
-                            score_part1 += score_battle_p1[S][choice_p1[Z]] + score_choice[Z];
-                            score_part2 += score_battle_p2[Z] + score_choice[choice_by_goal[Z][S]];
-                            break;
-                        default:
-                            fprintf(stderr, "Invalid selection by myself %c in line %d!", me, line);
-                            exit(EXIT_FAILURE);
-                            break;
-                    }
-                    break;
-                default:
-                    fprintf(stderr, "Invalid selection by opponent %c in line %d!", opponent, line);
-                    exit(EXIT_FAILURE);
-                    break;
-            }
-        }
-        else
+        /* xorshift64, https://en.wikipedia.org/wiki/Xorshift */
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+
+        buf[used++] = (char)('A' + ((rng >> 8) % 3U));
+        buf[used++] = ' ';
+        buf[used++] = (char)('X' + ((rng >> 24) % 3U));
+        buf[used++] = '\n';
+        if ((used + LINE_SIZE) > GEN_BUFFER_SIZE)
         {
-            fprintf(stderr, "Unexpected data in line %d!", line);
-            exit(EXIT_FAILURE);
+            ok = (fwrite(buf, 1U, used, fp) == used);
+            used = 0U;
         }
-        line++;
     }
-
-    printf("part 1: score = %d\n", score_part1);
-    printf("part 2: score = %d\n", score_part2);
-
-    fclose(fp);
+    ok = ok && (fwrite(buf, 1U, used, fp) == used);
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "Could not write file %s!\n", name);
+        return EXIT_FAILURE;
+    }
 
     return EXIT_SUCCESS;
 }
+
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1)
+{
+    return (double)(t1->tv_sec - t0->tv_sec) + ((double)(t1->tv_nsec - t0->tv_nsec) / 1e9);
+}
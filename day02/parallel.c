@@ -0,0 +1,106 @@
+/*
+ * Day 2 - module to count the rounds of a memory mapped input with several threads.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "parallel.h"
+
+#include "rounds.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct
+{
+    const char* text;
+    size_t size;
+    histogram_t histogram;  /* rounds of this chunk */
+    int ok;
+} chunk_t;
+
+static size_t find_line_start(const char* text, size_t size, size_t from);
+static void* chunk_worker(void* arg);
+
+int parallel_solve(const mapping_t* m, unsigned int threads, solver_result_t* result)
+{
+    assert((threads > 0U) && (threads <= PARALLEL_MAX_THREADS));
+
+    chunk_t chunks[PARALLEL_MAX_THREADS];
+    pthread_t workers[PARALLEL_MAX_THREADS];
+
+    size_t begin = 0U;
+    for (unsigned int i = 0U; i < threads; i++)
+    {
+        size_t end = m->size;
+        if ((i + 1U) < threads)
+            end = find_line_start(m->text, m->size, (m->size / threads) * (i + 1U));
+        if (end < begin)
+            end = begin;
+        chunks[i].text = m->text + begin;
+        chunks[i].size = end - begin;
+        begin = end;
+    }
+
+    /* the calling thread takes the first chunk */
+    unsigned int started = 1U;
+    for (; started < threads; started++)
+    {
+        if (pthread_create(&workers[started], NULL, chunk_worker, &chunks[started]) != 0)
+            break;
+    }
+    chunk_worker(&chunks[0]);
+    for (unsigned int i = started; i < threads; i++) /* not started, e.g. no resources */
+        chunk_worker(&chunks[i]);
+    for (unsigned int i = 1U; i < started; i++)
+        pthread_join(workers[i], NULL);
+
+    /* the scores only depend on how often each round occurs */
+    histogram_t total;
+    histogram_init(&total);
+    for (unsigned int i = 0U; i < threads; i++)
+    {
+        if (!chunks[i].ok)
+        {
+            fprintf(stderr, "Unexpected data in line %llu!",
+                    (unsigned long long)(total.line + chunks[i].histogram.line - 1U));
+            return 0;
+        }
+        histogram_merge(&total, &chunks[i].histogram);
+    }
+
+    scores_t scores;
+    histogram_scores(&total, &scores);
+    solver_answer(result, 1U, "%llu", scores.part1);
+    solver_answer(result, 2U, "%llu", scores.part2);
+
+    return 1;
+}
+
+/* get start of the first line at or after from */
+static size_t find_line_start(const char* text, size_t size, size_t from)
+{
+    if ((from == 0U) || (from >= size))
+        return from;
+
+    const char* eol = memchr(&text[from - 1U], '\n', size - (from - 1U));
+
+    return (eol != NULL) ? (size_t)(eol - text) + 1U : size;
+}
+
+static void* chunk_worker(void* arg)
+{
+    chunk_t* c = arg;
+
+    histogram_init(&c->histogram);
+    c->ok = rounds_count(&c->histogram, c->text, c->size);
+
+    return NULL;
+}
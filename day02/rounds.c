@@ -0,0 +1,262 @@
+/*
+ * Day 2 - module to score rounds of the strategy guide.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "rounds.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define SCORE_LOSS (0)
+#define SCORE_DRAW (3)
+#define SCORE_WIN  (6)
+
+#define SCORE_ROCK     (1)
+#define SCORE_PAPER    (2)
+#define SCORE_SCISSORS (3)
+
+#define VECTOR_SIZE (32U) /* bytes, i.e. 8 lines "A X\n" */
+
+/* part 1: X/Y/Z is my choice of rock/paper/scissors */
+const unsigned char round_score_p1[NUM_ROUND_INDICES] =
+{
+    [ROUND_INDEX('A', 'X')] = SCORE_DRAW + SCORE_ROCK,     /* rock vs. rock */
+    [ROUND_INDEX('A', 'Y')] = SCORE_WIN  + SCORE_PAPER,    /* rock vs. paper */
+    [ROUND_INDEX('A', 'Z')] = SCORE_LOSS + SCORE_SCISSORS, /* rock vs. scissors */
+    [ROUND_INDEX('B', 'X')] = SCORE_LOSS + SCORE_ROCK,     /* paper vs. rock */
+    [ROUND_INDEX('B', 'Y')] = SCORE_DRAW + SCORE_PAPER,    /* paper vs. paper */
+    [ROUND_INDEX('B', 'Z')] = SCORE_WIN  + SCORE_SCISSORS, /* paper vs. scissors */
+    [ROUND_INDEX('C', 'X')] = SCORE_WIN  + SCORE_ROCK,     /* scissors vs. rock */
+    [ROUND_INDEX('C', 'Y')] = SCORE_LOSS + SCORE_PAPER,    /* scissors vs. paper */
+    [ROUND_INDEX('C', 'Z')] = SCORE_DRAW + SCORE_SCISSORS  /* scissors vs. scissors */
+};
+
+/* part 2: X/Y/Z is the goal to lose/draw/win, the choice follows from it */
+const unsigned char round_score_p2[NUM_ROUND_INDICES] =
+{
+    [ROUND_INDEX('A', 'X')] = SCORE_LOSS + SCORE_SCISSORS, /* rock, lose */
+    [ROUND_INDEX('A', 'Y')] = SCORE_DRAW + SCORE_ROCK,     /* rock, draw */
+    [ROUND_INDEX('A', 'Z')] = SCORE_WIN  + SCORE_PAPER,    /* rock, win */
+    [ROUND_INDEX('B', 'X')] = SCORE_LOSS + SCORE_ROCK,     /* paper, lose */
+    [ROUND_INDEX('B', 'Y')] = SCORE_DRAW + SCORE_PAPER,    /* paper, draw */
+    [ROUND_INDEX('B', 'Z')] = SCORE_WIN  + SCORE_SCISSORS, /* paper, win */
+    [ROUND_INDEX('C', 'X')] = SCORE_LOSS + SCORE_PAPER,    /* scissors, lose */
+    [ROUND_INDEX('C', 'Y')] = SCORE_DRAW + SCORE_SCISSORS, /* scissors, draw */
+    [ROUND_INDEX('C', 'Z')] = SCORE_WIN  + SCORE_ROCK      /* scissors, win */
+};
+
+static int score_lines(scores_t* s, const char* text, size_t n, int vectors);
+static int parse_round(const char* text, size_t n, size_t* i, size_t line, int report, unsigned int* r);
+#if defined(__AVX2__)
+static size_t score_vectors(const char* text, size_t n, unsigned long long* part1, unsigned long long* part2);
+#endif
+
+void scores_init(scores_t* s)
+{
+    s->part1 = 0U;
+    s->part2 = 0U;
+    s->line = 1U;
+}
+
+int rounds_score(scores_t* s, const char* text, size_t n)
+{
+    return score_lines(s, text, n, 1);
+}
+
+int rounds_score_scalar(scores_t* s, const char* text, size_t n)
+{
+    return score_lines(s, text, n, 0);
+}
+
+static int score_lines(scores_t* s, const char* text, size_t n, int vectors)
+{
+    unsigned long long part1 = s->part1;
+    unsigned long long part2 = s->part2;
+    size_t line = s->line;
+    int ok = 1;
+
+    size_t i = 0U;
+    while (i < n)
+    {
+#if defined(__AVX2__)
+        /* as many lines as possible 8 at once, then one by one up to the
+         * next line which may start 8 valid lines again
+         */
+        if (vectors)
+        {
+            size_t done = score_vectors(&text[i], n - i, &part1, &part2);
+            i += done;
+            line += done / 4U;
+            if (i >= n)
+                break;
+        }
+#else
+        (void) vectors;
+#endif
+
+        unsigned int r;
+        if (!parse_round(text, n, &i, line, 1, &r))
+        {
+            ok = 0;
+            break;
+        }
+        part1 += round_score_p1[r];
+        part2 += round_score_p2[r];
+        line++;
+    }
+
+    s->part1 = part1;
+    s->part2 = part2;
+    s->line = line;
+
+    return ok;
+}
+
+void histogram_init(histogram_t* h)
+{
+    memset(h->count, 0, sizeof(h->count));
+    h->line = 1U;
+}
+
+int rounds_count(histogram_t* h, const char* text, size_t n)
+{
+    unsigned long long count[NUM_ROUND_INDICES];
+    size_t line = h->line;
+    int ok = 1;
+
+    memcpy(count, h->count, sizeof(count));
+
+    size_t i = 0U;
+    while (i < n)
+    {
+        unsigned int r;
+        if (!parse_round(text, n, &i, line, 0, &r))
+        {
+            ok = 0;
+            break;
+        }
+        count[r]++;
+        line++;
+    }
+
+    memcpy(h->count, count, sizeof(count));
+    h->line = line;
+
+    return ok;
+}
+
+void histogram_merge(histogram_t* dst, const histogram_t* src)
+{
+    for (size_t r = 0U; r < NUM_ROUND_INDICES; r++)
+        dst->count[r] += src->count[r];
+    dst->line += src->line - 1U;
+}
+
+void histogram_scores(const histogram_t* h, scores_t* s)
+{
+    scores_init(s);
+    for (size_t r = 0U; r < NUM_ROUND_INDICES; r++)
+    {
+        s->part1 += h->count[r] * round_score_p1[r];
+        s->part2 += h->count[r] * round_score_p2[r];
+    }
+    s->line = h->line;
+}
+
+/* get ROUND_INDEX() of the line at i and move i to the next line */
+static int parse_round(const char* text, size_t n, size_t* i, size_t line, int report, unsigned int* r)
+{
+    size_t k = *i;
+
+    if (((n - k) < 3U) || (text[k + 1U] != ' '))
+    {
+        if (report)
+            fprintf(stderr, "Unexpected data in line %llu!", (unsigned long long) line);
+        return 0;
+    }
+
+    char opponent = text[k];
+    char me = text[k + 2U];
+    if ((opponent < 'A') || (opponent > 'C'))
+    {
+        if (report)
+            fprintf(stderr, "Invalid selection by opponent %c in line %llu!", opponent, (unsigned long long) line);
+        return 0;
+    }
+    if ((me < 'X') || (me > 'Z'))
+    {
+        if (report)
+            fprintf(stderr, "Invalid selection by myself %c in line %llu!", me, (unsigned long long) line);
+        return 0;
+    }
+    *r = ROUND_INDEX(opponent, me);
+
+    k += 3U;
+    if ((k < n) && (text[k] == '\r'))
+        k++;
+    if (k < n)
+    {
+        if (text[k] != '\n')
+        {
+            if (report)
+                fprintf(stderr, "Unexpected data in line %llu!", (unsigned long long) line);
+            return 0;
+        }
+        k++;
+    }
+    *i = k;
+
+    return 1;
+}
+
+#if defined(__AVX2__)
+/* score blocks of 8 lines of exactly 4 bytes, returns number of bytes done */
+static size_t score_vectors(const char* text, size_t n, unsigned long long* part1, unsigned long long* part2)
+{
+    const __m256i base = _mm256_set1_epi32(('\n' << 24) | ('X' << 16) | (' ' << 8) | 'A');
+    const __m256i limit = _mm256_set1_epi32(2 << 16 | 2);   /* A-C, X-Z */
+    const __m256i low_bits = _mm256_set1_epi32(3);
+    const __m256i table_p1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) round_score_p1));
+    const __m256i table_p2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) round_score_p2));
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sum_p1 = zero;
+    __m256i sum_p2 = zero;
+
+    size_t i = 0U;
+    for (; (i + VECTOR_SIZE) <= n; i += VECTOR_SIZE)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) &text[i]);
+
+        /* each byte minus its expected base must not exceed its limit */
+        __m256i d = _mm256_sub_epi8(v, base);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(d, limit), d)) != -1)
+            break;
+
+        /* ROUND_INDEX() of each line in its lowest byte, 0 in the others */
+        __m256i idx = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(v, low_bits), 2),
+                                      _mm256_and_si256(_mm256_srli_epi32(v, 16), low_bits));
+
+        /* look up 16 bytes tables within each 128 bit lane, entry 0 is 0 */
+        sum_p1 = _mm256_add_epi64(sum_p1, _mm256_sad_epu8(_mm256_shuffle_epi8(table_p1, idx), zero));
+        sum_p2 = _mm256_add_epi64(sum_p2, _mm256_sad_epu8(_mm256_shuffle_epi8(table_p2, idx), zero));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, sum_p1);
+    *part1 += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256((__m256i*) lanes, sum_p2);
+    *part2 += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    return i;
+}
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Day 2 - module to score rounds of the strategy guide.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef ROUNDS_H_
+#define ROUNDS_H_
+
+#include <stdlib.h>
+
+/* a round "A X" is looked up by the two lowest bits of both letters */
+#define ROUND_INDEX(opponent, me) ((((unsigned int)(opponent) & 3U) << 2) | ((unsigned int)(me) & 3U))
+#define NUM_ROUND_INDICES (16U)
+
+typedef struct
+{
+    unsigned long long part1;
+    unsigned long long part2;
+    size_t line;    /* number of the next line, starting at 1 */
+} scores_t;
+
+/* number of rounds by ROUND_INDEX() */
+typedef struct
+{
+    unsigned long long count[NUM_ROUND_INDICES];
+    size_t line;    /* number of the next line, starting at 1 */
+} histogram_t;
+
+/* score of both parts by ROUND_INDEX(), 0 for invalid letters */
+extern const unsigned char round_score_p1[NUM_ROUND_INDICES];
+extern const unsigned char round_score_p2[NUM_ROUND_INDICES];
+
+/* start counting at the first line */
+void scores_init(scores_t* s);
+
+/*
+ * Add the scores of complete lines "A X", the last one may lack its line end.
+ * Returns 0 on unexpected data, the line is reported on stderr. If built with
+ * AVX2, runs of lines "A X\n" are scored 8 at once.
+ */
+int rounds_score(scores_t* s, const char* text, size_t n);
+
+/* same as rounds_score() line by line, as reference */
+int rounds_score_scalar(scores_t* s, const char* text, size_t n);
+
+/* start counting at the first line */
+void histogram_init(histogram_t* h);
+
+/*
+ * Count rounds of complete lines like rounds_score() scores them. Nothing is
+ * printed on unexpected data, the line of it is left in h->line.
+ */
+int rounds_count(histogram_t* h, const char* text, size_t n);
+
+/* add the rounds of src to dst */
+void histogram_merge(histogram_t* dst, const histogram_t* src);
+
+/* get the scores of all counted rounds */
+void histogram_scores(const histogram_t* h, scores_t* s);
+
+#endif /* ROUNDS_H_ */
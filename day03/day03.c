@@ -0,0 +1,140 @@
+/*
+ * Solver for advent of code 2022 day 3.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day03.h"
+
+#include "items.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_SIZE (65536U) /* longer rucksacks are streamed */
+
+typedef struct
+{
+    char* block;
+} state_t;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+
+const solver_t day03_solver =
+{
+    .name = "day03",
+    .title = "Day 3: Rucksack Reorganization",
+    .part =
+    {
+        "sum of same item priorities",
+        "sum of all badge priorities"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->block = malloc(BLOCK_SIZE);
+    if (s->block == NULL)
+    {
+        free(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    sums_t sums;
+
+    (void) log;
+
+    sums_init(&sums);
+
+    /*
+     * Score all complete lines of a block, the rest is moved to the front. A
+     * line filling a whole block is streamed until its end instead.
+     */
+    stream_t stream;
+    int streaming = 0;
+    size_t used = 0U;
+    size_t n;
+    while ((n = fread(&s->block[used], 1U, BLOCK_SIZE - used, fp)) > 0U)
+    {
+        used += n;
+        if (streaming)
+        {
+            const char* eol = memchr(s->block, '\n', used);
+            size_t head = (eol != NULL) ? ((size_t)(eol - s->block) + 1U) : used;
+            if (!rucksacks_stream(&stream, &sums, s->block, head))
+                return 0;
+            used -= head;
+            memmove(s->block, &s->block[head], used);
+            streaming = (eol == NULL);
+        }
+
+        const char* eol = NULL;
+        for (size_t i = used; i > 0U; i--)
+        {
+            if (s->block[i - 1U] == '\n')
+            {
+                eol = &s->block[i - 1U];
+                break;
+            }
+        }
+        if (eol == NULL)
+        {
+            if (used == BLOCK_SIZE)
+            {
+                stream_init(&stream);
+                if (!rucksacks_stream(&stream, &sums, s->block, used))
+                    return 0;
+                used = 0U;
+                streaming = 1;
+            }
+            continue;
+        }
+
+        size_t lines = (size_t)(eol - s->block) + 1U;
+        if (!rucksacks_score(&sums, s->block, lines))
+            return 0;
+        used -= lines;
+        memmove(s->block, &s->block[lines], used);
+    }
+    if (streaming)
+    {
+        if (!rucksacks_finish(&stream, &sums)) /* no line end */
+            return 0;
+    }
+    else if ((used > 0U) && !rucksacks_score(&sums, s->block, used)) /* no line end */
+    {
+        return 0;
+    }
+
+    solver_answer(result, 1U, "%llu", sums.part1);
+    solver_answer(result, 2U, "%llu", sums.part2);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    free(s->block);
+    free(s);
+}
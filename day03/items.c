@@ -0,0 +1,292 @@
+/*
+ * Day 3 - module to handle items of rucksacks as sets of priorities.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "items.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define GROUP_SIZE  (3U)
+#define VECTOR_SIZE (32U) /* items */
+
+static int score_lines(sums_t* s, const char* text, size_t n, int vectors);
+#if defined(__AVX2__)
+static uint64_t mask_vectors(const char* items, size_t n);
+#endif
+static int stream_line(stream_t* st, sums_t* s);
+static void add_rucksack(sums_t* s, uint64_t common, uint64_t rucksack);
+
+/* priority of each character, 0 for others than items */
+static const unsigned char priorities[256] =
+{
+    ['a'] = 1U, ['b'] = 2U, ['c'] = 3U, ['d'] = 4U, ['e'] = 5U, ['f'] = 6U,
+    ['g'] = 7U, ['h'] = 8U, ['i'] = 9U, ['j'] = 10U, ['k'] = 11U, ['l'] = 12U,
+    ['m'] = 13U, ['n'] = 14U, ['o'] = 15U, ['p'] = 16U, ['q'] = 17U, ['r'] = 18U,
+    ['s'] = 19U, ['t'] = 20U, ['u'] = 21U, ['v'] = 22U, ['w'] = 23U, ['x'] = 24U,
+    ['y'] = 25U, ['z'] = 26U,
+    ['A'] = 27U, ['B'] = 28U, ['C'] = 29U, ['D'] = 30U, ['E'] = 31U, ['F'] = 32U,
+    ['G'] = 33U, ['H'] = 34U, ['I'] = 35U, ['J'] = 36U, ['K'] = 37U, ['L'] = 38U,
+    ['M'] = 39U, ['N'] = 40U, ['O'] = 41U, ['P'] = 42U, ['Q'] = 43U, ['R'] = 44U,
+    ['S'] = 45U, ['T'] = 46U, ['U'] = 47U, ['V'] = 48U, ['W'] = 49U, ['X'] = 50U,
+    ['Y'] = 51U, ['Z'] = 52U
+};
+
+uint64_t items_mask(const char* items, size_t n)
+{
+#if defined(__AVX2__)
+    if (n < VECTOR_SIZE)
+        return items_mask_scalar(items, n);
+
+    size_t done = n - (n % VECTOR_SIZE);
+    return mask_vectors(items, done) | items_mask_scalar(&items[done], n - done);
+#else
+    return items_mask_scalar(items, n);
+#endif
+}
+
+uint64_t items_mask_scalar(const char* items, size_t n)
+{
+    uint64_t mask = 0U;
+    for (size_t i = 0U; i < n; i++)
+        mask |= (uint64_t) 1U << priorities[(unsigned char) items[i]];
+
+    return mask;
+}
+
+unsigned int items_priority(uint64_t mask)
+{
+    mask &= ~ITEMS_INVALID;
+    if (mask == 0U)
+        return 0U;
+
+#if defined(__GNUC__)
+    return (unsigned int) __builtin_ctzll(mask);
+#else
+    unsigned int p = 0U;
+    while ((mask & 1U) == 0U)
+    {
+        mask >>= 1;
+        p++;
+    }
+    return p;
+#endif
+}
+
+void sums_init(sums_t* s)
+{
+    s->part1 = 0U;
+    s->part2 = 0U;
+    s->group[0] = 0U;
+    s->group[1] = 0U;
+    s->in_group = 0U;
+    s->line = 1U;
+}
+
+int rucksacks_score(sums_t* s, const char* text, size_t n)
+{
+    return score_lines(s, text, n, 1);
+}
+
+int rucksacks_score_scalar(sums_t* s, const char* text, size_t n)
+{
+    return score_lines(s, text, n, 0);
+}
+
+static int score_lines(sums_t* s, const char* text, size_t n, int vectors)
+{
+    uint64_t (*mask)(const char*, size_t) = vectors ? items_mask : items_mask_scalar;
+    size_t i = 0U;
+    while (i < n)
+    {
+        const char* eol = memchr(&text[i], '\n', n - i);
+        size_t end = (eol != NULL) ? (size_t)(eol - text) : n;
+        size_t len = end - i;
+        if ((len > 0U) && (text[end - 1U] == '\r'))
+            len--;
+
+        if ((len % 2U) != 0U)
+        {
+            fprintf(stderr, "Invalid length in line %llu!", (unsigned long long) s->line);
+            return 0;
+        }
+
+        /* the second compartment starts anywhere in a vector, it is loaded unaligned */
+        uint64_t first = mask(&text[i], len / 2U);
+        uint64_t second = mask(&text[i + (len / 2U)], len / 2U);
+        if (((first | second) & ITEMS_INVALID) != 0U)
+        {
+            fprintf(stderr, "Invalid item in line %llu!", (unsigned long long) s->line);
+            return 0;
+        }
+        add_rucksack(s, first & second, first | second);
+        i = end + 1U;
+    }
+
+    return 1;
+}
+
+void stream_init(stream_t* st)
+{
+    st->seen = 0U;
+    st->length = 0U;
+    st->cr = 0;
+}
+
+int rucksacks_stream(stream_t* st, sums_t* s, const char* text, size_t n)
+{
+    for (size_t i = 0U; i < n; i++)
+    {
+        if (text[i] == '\n')
+        {
+            if (!stream_line(st, s))
+                return 0;
+            continue;
+        }
+
+        /* a carriage return is only allowed right before the line end */
+        if (st->cr)
+        {
+            st->seen |= ITEMS_INVALID;
+            st->length++;
+            st->cr = 0;
+        }
+        if (text[i] == '\r')
+        {
+            st->cr = 1;
+            continue;
+        }
+
+        unsigned int p = priorities[(unsigned char) text[i]];
+        uint64_t bit = (uint64_t) 1U << p;
+        if ((st->seen & bit) == 0U)
+        {
+            st->first[p] = st->length;
+            st->seen |= bit;
+        }
+        st->last[p] = st->length;
+        st->length++;
+    }
+
+    return 1;
+}
+
+int rucksacks_finish(stream_t* st, sums_t* s)
+{
+    if ((st->length == 0U) && !st->cr)
+        return 1;
+
+    return stream_line(st, s);
+}
+
+static int stream_line(stream_t* st, sums_t* s)
+{
+    if ((st->length % 2U) != 0U)
+    {
+        fprintf(stderr, "Invalid length in line %llu!", (unsigned long long) s->line);
+        return 0;
+    }
+    if ((st->seen & ITEMS_INVALID) != 0U)
+    {
+        fprintf(stderr, "Invalid item in line %llu!", (unsigned long long) s->line);
+        return 0;
+    }
+
+    /* an item is in both compartments if it occurs before and after the middle */
+    unsigned long long middle = st->length / 2U;
+    uint64_t common = 0U;
+    for (uint64_t rest = st->seen; rest != 0U; rest &= rest - 1U)
+    {
+        unsigned int p = items_priority(rest);
+        if ((st->first[p] < middle) && (st->last[p] >= middle))
+        {
+            common = (uint64_t) 1U << p;
+            break;
+        }
+    }
+    add_rucksack(s, common, st->seen);
+    stream_init(st);
+
+    return 1;
+}
+
+#if defined(__AVX2__)
+/*
+ * Set of a multiple of 32 items. The high nibble of each byte selects by
+ * pshufb the offset from character to priority and the range of priorities
+ * valid for it, others become 0. The priorities are widened to 32 bit lanes
+ * to shift a bit into the lower or upper half of the mask.
+ */
+static uint64_t mask_vectors(const char* items, size_t n)
+{
+    const __m256i offsets = _mm256_setr_epi8(0, 0, 0, 0, -38, -38, -96, -96, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 0, 0, 0, -38, -38, -96, -96, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i lowest = _mm256_setr_epi8(-1, -1, -1, -1, 27, 27, 1, 1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            -1, -1, -1, -1, 27, 27, 1, 1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i highest = _mm256_setr_epi8(0, 0, 0, 0, 52, 52, 26, 26, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 0, 0, 0, 52, 52, 26, 26, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i upper = _mm256_set1_epi32(32);
+    __m256i low = _mm256_setzero_si256();
+    __m256i high = _mm256_setzero_si256();
+
+    for (size_t i = 0U; i < n; i += VECTOR_SIZE)
+    {
+        __m256i c = _mm256_loadu_si256((const __m256i*) &items[i]);
+        __m256i h = _mm256_and_si256(_mm256_srli_epi16(c, 4), nibble);
+        __m256i p = _mm256_add_epi8(c, _mm256_shuffle_epi8(offsets, h));
+        __m256i valid = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_max_epu8(p, _mm256_shuffle_epi8(lowest, h)), p),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(p, _mm256_shuffle_epi8(highest, h)), p));
+        p = _mm256_and_si256(p, valid);
+
+        /* shifts by 32 or more, also of negative counts, give 0 */
+        __m128i bytes[2] = { _mm256_castsi256_si128(p), _mm256_extracti128_si256(p, 1) };
+        for (unsigned int k = 0U; k < 4U; k++)
+        {
+            __m128i b = (k % 2U) ? _mm_srli_si128(bytes[k / 2U], 8) : bytes[k / 2U];
+            __m256i q = _mm256_cvtepu8_epi32(b);
+            low = _mm256_or_si256(low, _mm256_sllv_epi32(one, q));
+            high = _mm256_or_si256(high, _mm256_sllv_epi32(one, _mm256_sub_epi32(q, upper)));
+        }
+    }
+
+    uint32_t lanes[2][8];
+    _mm256_storeu_si256((__m256i*) lanes[0], low);
+    _mm256_storeu_si256((__m256i*) lanes[1], high);
+    uint64_t mask = 0U;
+    for (unsigned int k = 0U; k < 8U; k++)
+        mask |= lanes[0][k] | ((uint64_t) lanes[1][k] << 32);
+
+    return mask;
+}
+#endif
+
+static void add_rucksack(sums_t* s, uint64_t common, uint64_t rucksack)
+{
+    /* part 1: item in both compartments */
+    s->part1 += items_priority(common);
+
+    /* part 2: item in all rucksacks of a group */
+    if (s->in_group < (GROUP_SIZE - 1U))
+    {
+        s->group[s->in_group++] = rucksack;
+    }
+    else
+    {
+        s->part2 += items_priority(s->group[0] & s->group[1] & rucksack);
+        s->in_group = 0U;
+    }
+
+    s->line++;
+}
@@ -0,0 +1,73 @@
+/*
+ * Day 3 - module to handle items of rucksacks as sets of priorities.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef ITEMS_H_
+#define ITEMS_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* bit p of a mask is set if an item of priority p (1 .. 52) is contained,
+ * bit 0 marks characters which are no items
+ */
+#define ITEMS_INVALID ((uint64_t) 1U)
+
+typedef struct
+{
+    unsigned long long part1;  /* sum of priorities of items in both compartments */
+    unsigned long long part2;  /* sum of priorities of badges */
+    uint64_t group[2];         /* items of the previous rucksacks of a group */
+    size_t in_group;           /* number of previous rucksacks of the group */
+    size_t line;               /* number of the next line, starting at 1 */
+} sums_t;
+
+typedef struct
+{
+    unsigned long long first[64];  /* position of the first item of each priority */
+    unsigned long long last[64];   /* position of the last item of each priority */
+    uint64_t seen;                 /* items of the line so far */
+    unsigned long long length;     /* items of the line so far */
+    int cr;                        /* line so far ends with a carriage return */
+} stream_t;
+
+/* get set of items, ITEMS_INVALID is added for other characters */
+uint64_t items_mask(const char* items, size_t n);
+
+/* same as items_mask() item by item, as reference */
+uint64_t items_mask_scalar(const char* items, size_t n);
+
+/* get priority of the item of lowest priority in the set, 0 if empty */
+unsigned int items_priority(uint64_t mask);
+
+/* start at the first rucksack of the first group */
+void sums_init(sums_t* s);
+
+/*
+ * Add the priorities of complete lines of rucksacks, the last one may lack its
+ * line end. Returns 0 on invalid rucksacks, the line is reported on stderr.
+ */
+int rucksacks_score(sums_t* s, const char* text, size_t n);
+
+/* same as rucksacks_score() with items_mask_scalar(), as reference */
+int rucksacks_score_scalar(sums_t* s, const char* text, size_t n);
+
+/* start at the beginning of a line */
+void stream_init(stream_t* st);
+
+/*
+ * Add the priorities of lines of any length, which may be split between calls
+ * anywhere. The state of the current line does not depend on its length, it
+ * is scored at its line end. Returns 0 on invalid rucksacks like above.
+ */
+int rucksacks_stream(stream_t* st, sums_t* s, const char* text, size_t n);
+
+/* score the last line if it lacks its line end */
+int rucksacks_finish(stream_t* st, sums_t* s);
+
+#endif /* ITEMS_H_ */
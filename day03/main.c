@@ -7,167 +7,297 @@
  * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
  */
 
+/*
+ * Besides the options of all days, this program accepts:
+ *
+ *   -k                      benchmark of scoring each file from memory by
+ *                           masks of compartments item by item, by AVX2 and
+ *                           by streaming
+ *   -g rucksacks items file generate an input of rucksacks of the given size
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "day03.h"
+#include "items.h"
+
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-#define RUCKSACK_CAPACITY (128U)
+#define BENCH_REPETITIONS (5U)
+#define GEN_BUFFER_SIZE   (65536U)
+#define GEN_POOL_SIZE     (18U) /* badge and 17 letters for each rucksack of a group */
+#define GEN_POOL_FIRST    (8U)  /* letters only in the first compartment */
 
-typedef struct
-{
-    size_t items_num;              /* number of items in the rucksack */
-    char items[RUCKSACK_CAPACITY]; /* items in the rucksack*/
-} rucksack_t;
+/* ways to score rucksacks, compared by -k */
+#define KERNEL_SCALAR  (0U)
+#define KERNEL_VECTORS (1U)
+#define KERNEL_STREAM  (2U)
+#define KERNELS        (3U)
 
-int compare_compartments(rucksack_t* rucksack);
-int determine_priority(char item);
-int find_common_badge(rucksack_t rucksacks[]);
-int compare_rucksacks(const void* a, const void* b);
+static int run_kernels(int files, char* names[]);
+static double time_kernel(unsigned int kernel, const char* data, size_t size, sums_t* s);
+static int read_file(const char* name, char** data, size_t* size);
+static int generate(const char* name, unsigned long long rucksacks, unsigned long items);
+static void shuffle(char* letters, size_t n);
+static size_t random_below(size_t n);
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1);
 
 int main(int argc, char *argv[])
 {
-    printf("Advent of Code 2022 - Day 3: Rucksack Reorganization\n\n");
+    int kernels = 0;
 
-    if (argc != 2)
+    /* day specific options are handled here, other arguments are passed on */
+    int args = 1;
+    for (int i = 1; i < argc; i++)
     {
-        fprintf(stderr, "Please provide data record file name.");
-        exit(EXIT_FAILURE);
+        if (strcmp(argv[i], "-k") == 0)
+        {
+            kernels = 1;
+        }
+        else if (strcmp(argv[i], "-g") == 0)
+        {
+            unsigned long long rucksacks;
+            unsigned long items;
+            if (   ((i + 3) >= argc)
+                || (sscanf(argv[i + 1], "%llu", &rucksacks) != 1)
+                || (sscanf(argv[i + 2], "%lu", &items) != 1)
+                || (rucksacks == 0U)
+                || (items == 0U)
+                || ((items % 2U) != 0U))
+            {
+                fprintf(stderr, "Invalid number of rucksacks, items (even) or file name!\n");
+                return EXIT_FAILURE;
+            }
+            return generate(argv[i + 3], rucksacks, items);
+        }
+        else
+        {
+            argv[args++] = argv[i];
+        }
     }
+    argv[args] = NULL;
 
-    FILE* fp = fopen(argv[1], "r");
+    if (kernels)
+        return run_kernels(args - 1, &argv[1]);
 
-    if (!fp)
-    {
-        fprintf(stderr, "Could not open file!");
-        exit(EXIT_FAILURE);
-    }
+    return solver_main(&day03_solver, args, argv);
+}
 
-    int priorities_sum_p1 = 0;
-    int priorities_sum_p2 = 0;
-    int rucksack_id = 0;
-    int i = 0;
-    rucksack_t rucksacks[3] = { 0 };
-    while (fgets(rucksacks[2].items, RUCKSACK_CAPACITY, fp))
+static int run_kernels(int files, char* names[])
+{
+    for (int i = 0; i < files; i++)
     {
-        rucksacks[2].items_num = strlen(rucksacks[2].items);
-        if (rucksacks[2].items_num > 0)
+        char* data;
+        size_t size;
+        if (!read_file(names[i], &data, &size))
         {
-            rucksacks[2].items_num--; // omit EOL
+            fprintf(stderr, "Could not read file %s!\n", names[i]);
+            return EXIT_FAILURE;
+        }
 
-            /* part 1 */
-            if ((rucksacks[2].items_num % 2U) == 0U)
-            {
-                priorities_sum_p1 += compare_compartments(&rucksacks[2]);
-            }
-            else
+        sums_t sums[KERNELS];
+        double t[KERNELS];
+        int ok = 1;
+        for (unsigned int k = 0U; ok && (k < KERNELS); k++)
+        {
+            t[k] = time_kernel(k, data, size, &sums[k]);
+            ok = (t[k] >= 0.0);
+        }
+        free(data);
+        if (!ok)
+            return EXIT_FAILURE;
+        for (unsigned int k = 1U; k < KERNELS; k++)
+        {
+            if ((sums[k].part1 != sums[0].part1) || (sums[k].part2 != sums[0].part2))
             {
-                fprintf(stderr, "Invalid length in line %d!", rucksack_id + 1U);
-                exit(EXIT_FAILURE);
+                fprintf(stderr, "Kernels disagree on file %s!\n", names[i]);
+                return EXIT_FAILURE;
             }
+        }
 
-            /* part 2 */
-            if (i < 2)
-            {
-                /* store two rucksacks */
-                memcpy(&rucksacks[i], &rucksacks[2], sizeof(rucksack_t));
-                i++;
-            }
-            else if (i >= 2)
+        static const char* const kernels[KERNELS] = { "scalar", "vectors", "stream" };
+        double rucksacks = (double)(sums[0].line - 1U);
+        printf("%s: %.0f rucksacks, sums %llu %llu\n", names[i], rucksacks, sums[0].part1, sums[0].part2);
+        for (unsigned int k = 0U; k < KERNELS; k++)
+        {
+#if !defined(__AVX2__)
+            if (k == KERNEL_VECTORS)
             {
-                /* evaluate three rucksacks */
-                priorities_sum_p2 += find_common_badge(rucksacks);
-                i = 0;
+                printf("vectors not built, compile with -mavx2\n");
+                continue;
             }
+#endif
+            printf("%-7s %9.1f MB/s %9.3f M rucksacks/s\n", kernels[k],
+                   ((double) size / t[k]) / 1e6, (rucksacks / t[k]) / 1e6);
         }
-
-        rucksack_id++;
     }
 
-    printf("part 1: sum of same item priorities = %d\n", priorities_sum_p1);
-    printf("part 2: sum of all badge priorities = %d\n", priorities_sum_p2);
-
-    fclose(fp);
-
     return EXIT_SUCCESS;
 }
 
-int compare_compartments(rucksack_t* rucksack)
+/* fastest of some runs, which is least disturbed by other processes, or -1 */
+static double time_kernel(unsigned int kernel, const char* data, size_t size, sums_t* s)
 {
-    /* first half / first compartment */
-    for (size_t c1i = 0U; c1i < rucksack->items_num / 2U; c1i++)
+    double best = 0.0;
+    for (unsigned int rep = 0U; rep < BENCH_REPETITIONS; rep++)
     {
-        /* second half / second compartment */
-        for (size_t c2i = rucksack->items_num / 2U; c2i < rucksack->items_num; c2i++)
+        struct timespec t0, t1;
+        stream_t st;
+        int ok;
+        sums_init(s);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        if (kernel == KERNEL_STREAM)
         {
-            /* determine priority of first item found in both compartments */
-            if (rucksack->items[c1i] == rucksack->items[c2i])
-            {
-                return determine_priority(rucksack->items[c1i]);
-            }
+            stream_init(&st);
+            ok = rucksacks_stream(&st, s, data, size) && rucksacks_finish(&st, s);
+        }
+        else if (kernel == KERNEL_VECTORS)
+        {
+            ok = rucksacks_score(s, data, size);
         }
+        else
+        {
+            ok = rucksacks_score_scalar(s, data, size);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (!ok)
+            return -1.0;
+        double t = elapsed_s(&t0, &t1);
+        if ((rep == 0U) || (t < best))
+            best = t;
     }
 
-    return 0;
+    return best;
 }
 
-int determine_priority(char item)
+static int read_file(const char* name, char** data, size_t* size)
 {
-    /* 1 .. 26 */
-    if ((item >= 'a') && (item <= 'z'))
-    {
-        return item - 96;
-    }
+    FILE* fp = fopen(name, "rb");
+    if (fp == NULL)
+        return 0;
 
-    /* 27 .. 52 */
-    if ((item >= 'A') && (item <= 'Z'))
+    int ok = 0;
+    long len;
+    if (   (fseek(fp, 0L, SEEK_END) == 0)
+        && ((len = ftell(fp)) >= 0L)
+        && (fseek(fp, 0L, SEEK_SET) == 0))
     {
-        return item - 38;
+        *size = (size_t) len;
+        *data = malloc((*size > 0U) ? *size : 1U);
+        ok = (*data != NULL) && (fread(*data, 1U, *size, fp) == *size);
+        if (!ok)
+            free(*data);
     }
+    fclose(fp);
 
-    return 0;
+    return ok;
 }
 
-int find_common_badge(rucksack_t rucksacks[])
+/*
+ * Rucksacks of a valid input, reproducible by a fixed seed: the letters are
+ * shuffled for each group, the first one is the badge followed by a disjoint
+ * pool of letters for each rucksack of the group. The item in both compartments
+ * is taken from the pool including the badge, the other letters of the pool
+ * are split between the compartments.
+ */
+static int generate(const char* name, unsigned long long rucksacks, unsigned long items)
 {
-    /* sort to have largest rucksack at lowest index */
-    qsort(rucksacks, 3U, sizeof(rucksack_t), compare_rucksacks);
+    FILE* fp = fopen(name, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return EXIT_FAILURE;
+    }
 
-    for (size_t s1 = 0U; s1 < rucksacks[0].items_num; s1++)
+    static char buf[GEN_BUFFER_SIZE];
+    char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    char pool[GEN_POOL_SIZE];
+    unsigned long half = items / 2U;
+    size_t used = 0U;
+    int ok = 1;
+    for (unsigned long long r = 0U; ok && (r < rucksacks); r++)
     {
-        for (size_t s2 = 0U; s2 < rucksacks[1].items_num; s2++)
+        size_t k = (size_t)(r % 3U);
+        if (k == 0U)
+            shuffle(letters, sizeof(letters) - 1U);
+
+        /* pool[0] is in both compartments, then the items of the first and the second */
+        pool[0] = letters[0];
+        memcpy(&pool[1], &letters[1U + (k * (GEN_POOL_SIZE - 1U))], GEN_POOL_SIZE - 1U);
+        shuffle(pool, GEN_POOL_SIZE);
+        size_t badge = (size_t)((char*) memchr(pool, letters[0], GEN_POOL_SIZE) - pool);
+        if (half < 2U) /* no room for another item, the badge has to be in both */
         {
-            /* determine shared items between the first two rucksacks */
-            if (rucksacks[0].items[s1] == rucksacks[1].items[s2])
+            pool[badge] = pool[0];
+            pool[0] = letters[0];
+            badge = 0U;
+        }
+
+        for (unsigned long i = 0U; ok && (i <= items); i++)
+        {
+            char c;
+            if (i == items)
+                c = '\n';
+            else if ((i == 0U) || (i == half))
+                c = pool[0];
+            else if ((i == 1U) && (badge > 0U) && (badge <= GEN_POOL_FIRST))
+                c = pool[badge];
+            else if ((i == (half + 1U)) && (badge > GEN_POOL_FIRST))
+                c = pool[badge];
+            else if (i < half)
+                c = pool[random_below(GEN_POOL_FIRST + 1U)];
+            else
             {
-                /* check if shared item is also in third rucksack */
-                for (size_t s3 = 0U; s3 < rucksacks[2].items_num; s3++)
-                {
-                    if (rucksacks[1].items[s2] == rucksacks[2].items[s3])
-                    {
-                        /* determine priority of first item found in all three
-                         * rucksacks:
-                         */
-                        return determine_priority(rucksacks[2].items[s3]);
-                    }
-                }
+                size_t j = random_below(GEN_POOL_SIZE - GEN_POOL_FIRST);
+                c = pool[(j == 0U) ? 0U : (GEN_POOL_FIRST + j)];
             }
-        }
 
+            buf[used++] = c;
+            if (used >= GEN_BUFFER_SIZE)
+            {
+                ok = (fwrite(buf, 1U, used, fp) == used);
+                used = 0U;
+            }
+        }
+    }
+    ok = ok && (fwrite(buf, 1U, used, fp) == used);
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "Could not write file %s!\n", name);
+        return EXIT_FAILURE;
     }
 
-    return 0;
+    return EXIT_SUCCESS;
+}
+
+/* Fisher-Yates shuffle */
+static void shuffle(char* letters, size_t n)
+{
+    for (size_t i = n - 1U; i > 0U; i--)
+    {
+        size_t j = random_below(i + 1U);
+        char c = letters[i];
+        letters[i] = letters[j];
+        letters[j] = c;
+    }
 }
 
-int compare_rucksacks(const void* a, const void* b)
+/* xorshift64, https://en.wikipedia.org/wiki/Xorshift */
+static size_t random_below(size_t n)
 {
-    const rucksack_t* arg1 = (const rucksack_t*)a;
-    const rucksack_t* arg2 = (const rucksack_t*)b;
+    static unsigned long long rng = 88172645463325252U;
 
-    if (arg1->items_num < arg2->items_num)
-        return 1;
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
 
-    if (arg1->items_num > arg2->items_num)
-        return -1;
+    return (size_t)((rng >> 8) % n);
+}
 
-    return 0;
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1)
+{
+    return (double)(t1->tv_sec - t0->tv_sec) + ((double)(t1->tv_nsec - t0->tv_nsec) / 1e9);
 }
@@ -0,0 +1,119 @@
+/*
+ * Solver for advent of code 2022 day 4.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day04.h"
+
+#include "sections.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_SIZE (65536U)
+#define MIN_LINE   (8U)     /* "1-1,1-1\n" */
+
+typedef struct
+{
+    char* block;
+    pairs_t pairs;
+} state_t;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+
+const solver_t day04_solver =
+{
+    .name = "day04",
+    .title = "Day 4: Camp Cleanup",
+    .part =
+    {
+        "number of ranges contained by another one",
+        "number of ranges with overlap"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->block = malloc(BLOCK_SIZE);
+    if ((s->block == NULL) || !pairs_init(&s->pairs, BLOCK_SIZE / MIN_LINE))
+    {
+        free(s->block);
+        free(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    counts_t counts = { 0U, 0U };
+
+    (void) log;
+
+    /* parse all complete lines of a block into arrays and count them at once */
+    s->pairs.line = 1U;
+    size_t used = 0U;
+    size_t n;
+    while ((n = fread(&s->block[used], 1U, BLOCK_SIZE - used, fp)) > 0U)
+    {
+        used += n;
+        const char* eol = NULL;
+        for (size_t i = used; i > 0U; i--)
+        {
+            if (s->block[i - 1U] == '\n')
+            {
+                eol = &s->block[i - 1U];
+                break;
+            }
+        }
+        if (eol == NULL)
+        {
+            if (used < BLOCK_SIZE)
+                continue;
+            fprintf(stderr, "Unexpected data in line %llu!", (unsigned long long) s->pairs.line);
+            return 0;
+        }
+
+        size_t lines = (size_t)(eol - s->block) + 1U;
+        pairs_clear(&s->pairs);
+        if (!pairs_parse(&s->pairs, s->block, lines))
+            return 0;
+        pairs_count(&s->pairs, &counts);
+        used -= lines;
+        memmove(s->block, &s->block[lines], used);
+    }
+    pairs_clear(&s->pairs);
+    if (!pairs_parse(&s->pairs, s->block, used)) /* no line end */
+        return 0;
+    pairs_count(&s->pairs, &counts);
+
+    solver_answer(result, 1U, "%llu", counts.contained);
+    solver_answer(result, 2U, "%llu", counts.overlap);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    free(s->block);
+    pairs_free(&s->pairs);
+    free(s);
+}
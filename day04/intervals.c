@@ -0,0 +1,368 @@
+/*
+ * Day 4 - module to index the ranges of all pairs for queries of sections.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "intervals.h"
+
+#include <limits.h>
+#include <string.h>
+
+#define WORD_BITS (64U)
+
+typedef struct
+{
+    range_t range;
+    size_t id;
+} entry_t;
+
+/* ranges starting at limit or before and ending at need or later */
+typedef struct
+{
+    int limit;
+    int need;
+    size_t* ids;
+    size_t max;
+    size_t found;
+} search_t;
+
+static int compare_entries(const void* a, const void* b);
+static int compare_ends(const void* a, const void* b);
+static int build_reach(intervals_t* t, size_t lo, size_t hi);
+static int build_levels(intervals_t* t);
+static size_t count_starting(const intervals_t* t, int limit);
+static size_t rank_of(const intervals_t* t, int end);
+static size_t count_below(const intervals_t* t, size_t n, size_t rank);
+static size_t ones_before(const intervals_t* t, unsigned int level, size_t pos);
+static void visit(const intervals_t* t, size_t lo, size_t hi, search_t* s);
+static size_t popcount(uint64_t w);
+
+int intervals_build(intervals_t* t, const pairs_t* p)
+{
+    size_t n = 0U;
+    size_t size = (p->used * NUM_ELVES_) + 1U;
+
+    memset(t, 0, sizeof(intervals_t));
+    entry_t* entries = malloc(size * sizeof(entry_t));
+    t->ranges = malloc(size * sizeof(range_t));
+    t->ids = malloc(size * sizeof(size_t));
+    t->reach = malloc(size * sizeof(int));
+    t->ends = malloc(size * sizeof(int));
+    if (   (entries == NULL) || (t->ranges == NULL) || (t->ids == NULL)
+        || (t->reach == NULL) || (t->ends == NULL))
+    {
+        free(entries);
+        intervals_free(t);
+        return 0;
+    }
+
+    for (size_t i = 0U; i < p->used; i++)
+    {
+        for (unsigned int e = 0U; e < NUM_ELVES_; e++)
+        {
+            if (p->min[e][i] > p->max[e][i])
+                continue;
+            entries[n].range.min = p->min[e][i];
+            entries[n].range.max = p->max[e][i];
+            entries[n].id = (i * NUM_ELVES_) + e;
+            n++;
+        }
+    }
+    qsort(entries, n, sizeof(entry_t), compare_entries);
+
+    for (size_t i = 0U; i < n; i++)
+    {
+        t->ranges[i] = entries[i].range;
+        t->ids[i] = entries[i].id;
+        t->ends[i] = entries[i].range.max;
+    }
+    free(entries);
+    t->size = n;
+    (void) build_reach(t, 0U, n);
+
+    /* distinct last sections */
+    qsort(t->ends, n, sizeof(int), compare_ends);
+    for (size_t i = 0U; i < n; i++)
+    {
+        if ((t->distinct == 0U) || (t->ends[i] != t->ends[t->distinct - 1U]))
+            t->ends[t->distinct++] = t->ends[i];
+    }
+
+    if (!build_levels(t))
+    {
+        intervals_free(t);
+        return 0;
+    }
+
+    return 1;
+}
+
+void intervals_free(intervals_t* t)
+{
+    free(t->ranges);
+    free(t->ids);
+    free(t->reach);
+    free(t->ends);
+    free(t->bits);
+    free(t->ones);
+    memset(t, 0, sizeof(intervals_t));
+}
+
+size_t intervals_count(const intervals_t* t, range_t q, int contain)
+{
+    if (q.min > q.max)
+        return 0U;
+
+    int limit = contain ? q.min : q.max;
+    int need = contain ? q.max : q.min;
+    size_t starting = count_starting(t, limit);
+
+    return starting - count_below(t, starting, rank_of(t, need));
+}
+
+size_t intervals_find(const intervals_t* t, range_t q, int contain, size_t* ids, size_t max)
+{
+    if (q.min > q.max)
+        return 0U;
+
+    search_t s =
+    {
+        .limit = contain ? q.min : q.max,
+        .need = contain ? q.max : q.min,
+        .ids = ids,
+        .max = max,
+        .found = 0U
+    };
+    visit(t, 0U, t->size, &s);
+
+    return s.found;
+}
+
+void intervals_query(const intervals_t* t, const range_t* q, size_t n, answer_t* answers)
+{
+    for (size_t i = 0U; i < n; i++)
+    {
+        answers[i].overlap = intervals_count(t, q[i], 0);
+        answers[i].contain = intervals_count(t, q[i], 1);
+    }
+}
+
+static int compare_entries(const void* a, const void* b)
+{
+    const entry_t* x = a;
+    const entry_t* y = b;
+
+    if (x->range.min != y->range.min)
+        return (x->range.min < y->range.min) ? -1 : 1;
+    if (x->id != y->id)
+        return (x->id < y->id) ? -1 : 1;
+
+    return 0;
+}
+
+static int compare_ends(const void* a, const void* b)
+{
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+
+    return (x > y) - (x < y);
+}
+
+/* returns the highest last section of ranges[lo .. hi - 1] */
+static int build_reach(intervals_t* t, size_t lo, size_t hi)
+{
+    if (lo >= hi)
+        return INT_MIN;
+
+    size_t mid = lo + ((hi - lo) / 2U);
+    int reach = t->ranges[mid].max;
+    int left = build_reach(t, lo, mid);
+    int right = build_reach(t, mid + 1U, hi);
+    if (left > reach)
+        reach = left;
+    if (right > reach)
+        reach = right;
+    t->reach[mid] = reach;
+
+    return reach;
+}
+
+/*
+ * Each level holds one bit of the ranks, then the ranks are sorted stably by
+ * that bit for the next level: zeros first.
+ */
+static int build_levels(intervals_t* t)
+{
+    t->levels = 0U;
+    while ((t->levels < INTERVALS_MAX_LEVELS) && (((size_t) 1U << t->levels) < t->distinct))
+        t->levels++;
+    t->words = (t->size / WORD_BITS) + 1U;
+
+    size_t* ranks = malloc((t->size + 1U) * sizeof(size_t));
+    size_t* next = malloc((t->size + 1U) * sizeof(size_t));
+    t->bits = calloc((t->levels * t->words) + 1U, sizeof(uint64_t));
+    t->ones = malloc(((t->levels * t->words) + 1U) * sizeof(size_t));
+    if ((ranks == NULL) || (next == NULL) || (t->bits == NULL) || (t->ones == NULL))
+    {
+        free(ranks);
+        free(next);
+        return 0;
+    }
+
+    for (size_t i = 0U; i < t->size; i++)
+        ranks[i] = rank_of(t, t->ranges[i].max);
+
+    for (unsigned int level = 0U; level < t->levels; level++)
+    {
+        unsigned int bit = t->levels - 1U - level;
+        uint64_t* words = &t->bits[level * t->words];
+        size_t zeros = 0U;
+        for (size_t i = 0U; i < t->size; i++)
+        {
+            if (((ranks[i] >> bit) & 1U) != 0U)
+                words[i / WORD_BITS] |= (uint64_t) 1U << (i % WORD_BITS);
+            else
+                zeros++;
+        }
+        t->zeros[level] = zeros;
+
+        size_t ones = 0U;
+        for (size_t w = 0U; w < t->words; w++)
+        {
+            t->ones[(level * t->words) + w] = ones;
+            ones += popcount(words[w]);
+        }
+
+        size_t z = 0U;
+        size_t o = zeros;
+        for (size_t i = 0U; i < t->size; i++)
+        {
+            if (((ranks[i] >> bit) & 1U) != 0U)
+                next[o++] = ranks[i];
+            else
+                next[z++] = ranks[i];
+        }
+        size_t* swap = ranks;
+        ranks = next;
+        next = swap;
+    }
+    free(ranks);
+    free(next);
+
+    return 1;
+}
+
+/* number of ranges starting at limit or before */
+static size_t count_starting(const intervals_t* t, int limit)
+{
+    size_t lo = 0U;
+    size_t hi = t->size;
+    while (lo < hi)
+    {
+        size_t mid = lo + ((hi - lo) / 2U);
+        if (t->ranges[mid].min <= limit)
+            lo = mid + 1U;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/* number of distinct last sections below end */
+static size_t rank_of(const intervals_t* t, int end)
+{
+    size_t lo = 0U;
+    size_t hi = t->distinct;
+    while (lo < hi)
+    {
+        size_t mid = lo + ((hi - lo) / 2U);
+        if (t->ends[mid] < end)
+            lo = mid + 1U;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/* number of the first n ranges (by first section) with a rank below rank */
+static size_t count_below(const intervals_t* t, size_t n, size_t rank)
+{
+    if (rank >= ((size_t) 1U << t->levels))
+        return n;
+
+    /* the first n ranges stay at the front of their part on each level */
+    size_t below = 0U;
+    size_t start = 0U;
+    size_t end = n;
+    for (unsigned int level = 0U; level < t->levels; level++)
+    {
+        unsigned int bit = t->levels - 1U - level;
+        size_t start_ones = ones_before(t, level, start);
+        size_t end_ones = ones_before(t, level, end);
+        if (((rank >> bit) & 1U) != 0U)
+        {
+            below += (end - end_ones) - (start - start_ones);
+            start = t->zeros[level] + start_ones;
+            end = t->zeros[level] + end_ones;
+        }
+        else
+        {
+            start -= start_ones;
+            end -= end_ones;
+        }
+    }
+
+    return below;
+}
+
+static size_t ones_before(const intervals_t* t, unsigned int level, size_t pos)
+{
+    size_t w = (level * t->words) + (pos / WORD_BITS);
+    uint64_t mask = ((uint64_t) 1U << (pos % WORD_BITS)) - 1U;
+
+    return t->ones[w] + popcount(t->bits[w] & mask);
+}
+
+static void visit(const intervals_t* t, size_t lo, size_t hi, search_t* s)
+{
+    while (lo < hi)
+    {
+        size_t mid = lo + ((hi - lo) / 2U);
+        if (t->reach[mid] < s->need)
+            return;
+
+        visit(t, lo, mid, s);
+        if (s->found == s->max)
+            return;
+
+        /* all ranges of the right subtree start behind this one */
+        if (t->ranges[mid].min > s->limit)
+            return;
+        if (t->ranges[mid].max >= s->need)
+        {
+            if (s->found == s->max)
+                return;
+            s->ids[s->found++] = t->ids[mid];
+        }
+        lo = mid + 1U;
+    }
+}
+
+static size_t popcount(uint64_t w)
+{
+#if defined(__GNUC__)
+    return (size_t) __builtin_popcountll(w);
+#else
+    /* https://en.wikipedia.org/wiki/Hamming_weight */
+    w = w - ((w >> 1) & 0x5555555555555555U);
+    w = (w & 0x3333333333333333U) + ((w >> 2) & 0x3333333333333333U);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FU;
+    return (size_t)((w * 0x0101010101010101U) >> 56);
+#endif
+}
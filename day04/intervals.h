@@ -0,0 +1,71 @@
+/*
+ * Day 4 - module to index the ranges of all pairs for queries of sections.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef INTERVALS_H_
+#define INTERVALS_H_
+
+#include "sections.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define INTERVALS_MAX_LEVELS (64U)
+
+/*
+ * The ranges sorted by their first section form an implicit balanced search
+ * tree, the middle of each part of the array being the root of its subtree.
+ * Each node knows the highest last section of its subtree, so subtrees with
+ * no range reaching a query are skipped when listing ranges.
+ *
+ * Ranges are counted by a wavelet matrix of the ranks of their last sections
+ * in the same order: it tells how many of the ranges starting up to a section
+ * end at another one or later, one bit level at a time.
+ *
+ * Empty ranges "b-a" are not indexed.
+ */
+typedef struct
+{
+    range_t* ranges;    /* sorted by first section */
+    size_t* ids;        /* range of the first elf of line l is 2 * (l - 1), the second's + 1 */
+    int* reach;         /* highest last section of the subtree of each range */
+    size_t size;
+
+    int* ends;          /* distinct last sections, sorted */
+    size_t distinct;
+    uint64_t* bits;     /* levels of bits of ranks, most significant first */
+    size_t* ones;       /* bits set in each level before each word */
+    size_t zeros[INTERVALS_MAX_LEVELS];
+    size_t words;       /* per level */
+    unsigned int levels;
+} intervals_t;
+
+typedef struct
+{
+    size_t overlap;     /* ranges with a section of the query */
+    size_t contain;     /* ranges with all sections of the query */
+} answer_t;
+
+/* index all pairs, returns 0 if there is not enough memory */
+int intervals_build(intervals_t* t, const pairs_t* p);
+
+void intervals_free(intervals_t* t);
+
+/* number of ranges overlapping q, or containing it if contain is set */
+size_t intervals_count(const intervals_t* t, range_t q, int contain);
+
+/*
+ * Find the ranges like intervals_count() in order of their first sections.
+ * The search stops after max ids, the number of stored ids is returned.
+ */
+size_t intervals_find(const intervals_t* t, range_t q, int contain, size_t* ids, size_t max);
+
+/* answer n queries by counting */
+void intervals_query(const intervals_t* t, const range_t* q, size_t n, answer_t* answers);
+
+#endif /* INTERVALS_H_ */
@@ -7,100 +7,344 @@
  * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
  */
 
+/*
+ * Besides the options of all days, this program accepts:
+ *
+ *   -k             benchmark of counting the parsed pairs of each file, scalar
+ *                  vs. AVX2
+ *   -g pairs file  generate an input of the given number of pairs
+ *   -q file queries
+ *                  index the ranges of all pairs of a file and answer queries
+ *                  "a-b" from a file or standard input "-" by the numbers of
+ *                  ranges overlapping and containing the sections a to b, the
+ *                  first containing ones are listed as line/elf
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "day04.h"
+#include "intervals.h"
+#include "sections.h"
+
 #include <stdio.h>
-#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-#define MAX_LINE_SIZE (64U)
+#define BENCH_REPETITIONS (5U)
+#define BENCH_PAIRS       (1048576U) /* initial size of the arrays */
+#define GEN_BUFFER_SIZE   (65536U)
+#define GEN_SECTIONS      (99U)
+#define QUERY_BATCH       (4096U)
+#define QUERY_LIST        (8U) /* containing ranges listed for a query */
 
-enum
-{
-    ELF_FIRST = 0,
-    ELF_SECOND,
-    NUM_ELVES_
-};
+static int run_kernels(int files, char* names[]);
+static int run_queries(const char* ranges, const char* queries);
+static int answer_batch(const intervals_t* t, const range_t* q, size_t n, double* total);
+static int parse_file(const char* name, pairs_t* p);
+static double time_kernel(void (*count)(const pairs_t*, counts_t*), const pairs_t* p, counts_t* c);
+static int generate(const char* name, unsigned long long pairs);
+static unsigned int random_below(unsigned int n);
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1);
 
-typedef struct
+int main(int argc, char *argv[])
 {
-    int min;
-    int max;
-} range_t;
+    int kernels = 0;
 
-int main(int argc, char *argv[])
+    /* day specific options are handled here, other arguments are passed on */
+    int args = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-k") == 0)
+        {
+            kernels = 1;
+        }
+        else if (strcmp(argv[i], "-g") == 0)
+        {
+            unsigned long long pairs;
+            if (   ((i + 2) >= argc)
+                || (sscanf(argv[i + 1], "%llu", &pairs) != 1)
+                || (pairs == 0U))
+            {
+                fprintf(stderr, "Invalid number of pairs or file name!\n");
+                return EXIT_FAILURE;
+            }
+            return generate(argv[i + 2], pairs);
+        }
+        else if (strcmp(argv[i], "-q") == 0)
+        {
+            if ((i + 2) >= argc)
+            {
+                fprintf(stderr, "Missing file of ranges or queries!\n");
+                return EXIT_FAILURE;
+            }
+            return run_queries(argv[i + 1], argv[i + 2]);
+        }
+        else
+        {
+            argv[args++] = argv[i];
+        }
+    }
+    argv[args] = NULL;
+
+    if (kernels)
+        return run_kernels(args - 1, &argv[1]);
+
+    return solver_main(&day04_solver, args, argv);
+}
+
+static int run_kernels(int files, char* names[])
 {
-    printf("Advent of Code 2022 - Day 4: Camp Cleanup\n\n");
+    for (int i = 0; i < files; i++)
+    {
+        pairs_t p;
+        if (!pairs_init(&p, BENCH_PAIRS))
+        {
+            fprintf(stderr, "Not enough memory!\n");
+            return EXIT_FAILURE;
+        }
+
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int ok = parse_file(names[i], &p);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (!ok)
+        {
+            pairs_free(&p);
+            return EXIT_FAILURE;
+        }
+
+        counts_t scalar;
+        counts_t vector;
+        double parse_s = elapsed_s(&t0, &t1);
+        double scalar_s = time_kernel(pairs_count_scalar, &p, &scalar);
+        double vector_s = time_kernel(pairs_count, &p, &vector);
+        double pairs = (double) p.used;
+        pairs_free(&p);
+        if ((scalar.contained != vector.contained) || (scalar.overlap != vector.overlap))
+        {
+            fprintf(stderr, "Counts of scalar and vectors differ!\n");
+            return EXIT_FAILURE;
+        }
+
+        printf("%s: %.0f pairs, counts %llu %llu\n", names[i], pairs, scalar.contained, scalar.overlap);
+        printf("parse   %9.1f M pairs/s\n", (pairs / parse_s) / 1e6);
+        printf("scalar  %9.1f M pairs/s\n", (pairs / scalar_s) / 1e6);
+#if defined(__AVX2__)
+        printf("vectors %9.1f M pairs/s\n", (pairs / vector_s) / 1e6);
+#else
+        (void) vector_s;
+        printf("vectors not built, compile with -mavx2\n");
+#endif
+    }
 
-    if (argc != 2)
+    return EXIT_SUCCESS;
+}
+
+static int run_queries(const char* ranges, const char* queries)
+{
+    pairs_t p;
+    intervals_t t;
+    if (!pairs_init(&p, BENCH_PAIRS))
     {
-        fprintf(stderr, "Please provide data record file name.");
-        exit(EXIT_FAILURE);
+        fprintf(stderr, "Not enough memory!\n");
+        return EXIT_FAILURE;
     }
 
-    FILE* fp = fopen(argv[1], "r");
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int ok = parse_file(ranges, &p) && intervals_build(&t, &p);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    pairs_free(&p);
+    if (!ok)
+        return EXIT_FAILURE;
+    printf("%llu ranges indexed in %.3f s\n", (unsigned long long) t.size, elapsed_s(&t0, &t1));
 
-    if (!fp)
+    int interactive = (strcmp(queries, "-") == 0);
+    FILE* fp = interactive ? stdin : fopen(queries, "rb");
+    if (fp == NULL)
     {
-        fprintf(stderr, "Could not open file!");
-        exit(EXIT_FAILURE);
+        fprintf(stderr, "Could not open file %s!\n", queries);
+        intervals_free(&t);
+        return EXIT_FAILURE;
     }
 
-    char line_buf[MAX_LINE_SIZE];
-    int line = 0;
-    int count_contained = 0;
-    int count_overlap = 0;
-    while (fgets(line_buf, MAX_LINE_SIZE, fp))
+    /* queries are answered in batches, one by one if typed in */
+    static range_t batch[QUERY_BATCH];
+    char* line = NULL; /* queries may be of any length */
+    size_t size = 0U;
+    ssize_t len;
+    unsigned long long count = 0U;
+    double total = 0.0;
+    size_t n = 0U;
+    while (ok && ((len = getline(&line, &size, fp)) != -1))
     {
-        range_t ranges[NUM_ELVES_] = { 0 };
-        if (sscanf(line_buf, "%d-%d,%d-%d",
-                &ranges[ELF_FIRST].min,
-                &ranges[ELF_FIRST].max,
-                &ranges[ELF_SECOND].min,
-                &ranges[ELF_SECOND].max) == 4)
+        size_t i = 0U;
+        count++;
+        if (!range_parse_line(line, (size_t) len, &i, &batch[n]) || (i != (size_t) len))
         {
-            /* part 1 */
+            fprintf(stderr, "Unexpected data in query %llu!\n", count);
+            ok = 0;
+            break;
+        }
+        n++;
+        if (interactive || (n == QUERY_BATCH))
+        {
+            ok = answer_batch(&t, batch, n, &total);
+            n = 0U;
+        }
+    }
+    ok = ok && answer_batch(&t, batch, n, &total);
+    free(line);
+    if (!interactive)
+        fclose(fp);
+    intervals_free(&t);
+    if (!ok)
+        return EXIT_FAILURE;
 
-            /* check if first range is within second range */
-            if (   (ranges[ELF_FIRST].min >= ranges[ELF_SECOND].min)
-                && (ranges[ELF_FIRST].max <= ranges[ELF_SECOND].max))
-            {
-                count_contained++;
-            }
-            /* check if second range is within first range */
-            else if (   (ranges[ELF_SECOND].min >= ranges[ELF_FIRST].min)
-                     && (ranges[ELF_SECOND].max <= ranges[ELF_FIRST].max))
-            {
-                count_contained++;
-            }
+    if (count > 0U)
+        printf("%llu queries in %.3f us each\n", count, (total / (double) count) * 1e6);
 
-            /* part 2 */
+    return EXIT_SUCCESS;
+}
 
-            /* check if first range has overlap with second range */
-            if (   (   (ranges[ELF_FIRST].min >= ranges[ELF_SECOND].min)
-                    && (ranges[ELF_FIRST].min <= ranges[ELF_SECOND].max))
-                || (   (ranges[ELF_FIRST].max >= ranges[ELF_SECOND].min)
-                    && (ranges[ELF_FIRST].max <= ranges[ELF_SECOND].max)))
-            {
-                count_overlap++;
-            }
-            /* check if second range has overlap with first range */
-            else if (   (   (ranges[ELF_SECOND].min >= ranges[ELF_FIRST].min)
-                         && (ranges[ELF_SECOND].min <= ranges[ELF_FIRST].max))
-                     || (   (ranges[ELF_SECOND].max >= ranges[ELF_FIRST].min)
-                         && (ranges[ELF_SECOND].max <= ranges[ELF_FIRST].max)))
-            {
-                count_overlap++;
-            }
-        }
-        else
+/* the batch is timed without printing its answers */
+static int answer_batch(const intervals_t* t, const range_t* q, size_t n, double* total)
+{
+    static answer_t answers[QUERY_BATCH];
+    struct timespec t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    intervals_query(t, q, n, answers);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    *total += elapsed_s(&t0, &t1);
+
+    for (size_t i = 0U; i < n; i++)
+    {
+        size_t ids[QUERY_LIST];
+        size_t found = intervals_find(t, q[i], 1, ids, QUERY_LIST);
+        printf("%d-%d: %llu overlapping, %llu containing", q[i].min, q[i].max,
+               (unsigned long long) answers[i].overlap, (unsigned long long) answers[i].contain);
+        for (size_t k = 0U; k < found; k++)
         {
-            fprintf(stderr, "Unexpected data in line %d!", line);
-            exit(EXIT_FAILURE);
+            printf(" %llu/%u", (unsigned long long)((ids[k] / NUM_ELVES_) + 1U),
+                   (unsigned int)(ids[k] % NUM_ELVES_) + 1U);
         }
-        line++;
+        printf((answers[i].contain > found) ? " ...\n" : "\n");
+    }
+
+    return (fflush(stdout) == 0);
+}
+
+/* all pairs of a file into one set of arrays */
+static int parse_file(const char* name, pairs_t* p)
+{
+    static char block[GEN_BUFFER_SIZE];
+
+    FILE* fp = fopen(name, "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return 0;
     }
-    printf("part 1: number of ranges contained by another one = %d\n", count_contained);
-    printf("part 2: number of ranges with overlap = %d\n", count_overlap);
 
+    int ok = 1;
+    size_t used = 0U;
+    size_t n;
+    while (ok && ((n = fread(&block[used], 1U, sizeof(block) - used, fp)) > 0U))
+    {
+        used += n;
+        size_t lines = used;
+        while ((lines > 0U) && (block[lines - 1U] != '\n'))
+            lines--;
+        if (lines == 0U)
+        {
+            ok = (used < sizeof(block));
+            continue;
+        }
+        ok = pairs_parse(p, block, lines);
+        used -= lines;
+        memmove(block, &block[lines], used);
+    }
+    ok = ok && pairs_parse(p, block, used);
     fclose(fp);
+    if (!ok)
+        fprintf(stderr, "\nCould not parse file %s!\n", name);
+
+    return ok;
+}
+
+/* fastest of some runs, which is least disturbed by other processes */
+static double time_kernel(void (*count)(const pairs_t*, counts_t*), const pairs_t* p, counts_t* c)
+{
+    double best = 0.0;
+    for (unsigned int rep = 0U; rep < BENCH_REPETITIONS; rep++)
+    {
+        struct timespec t0, t1;
+        c->contained = 0U;
+        c->overlap = 0U;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        count(p, c);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double t = elapsed_s(&t0, &t1);
+        if ((rep == 0U) || (t < best))
+            best = t;
+    }
+
+    return best;
+}
+
+/* pairs of random ranges of sections 1 .. 99, reproducible by a fixed seed */
+static int generate(const char* name, unsigned long long pairs)
+{
+    FILE* fp = fopen(name, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return EXIT_FAILURE;
+    }
+
+    static char buf[GEN_BUFFER_SIZE];
+    size_t used = 0U;
+    int ok = 1;
+    for (unsigned long long i = 0U; ok && (i < pairs); i++)
+    {
+        unsigned int section[4];
+        for (unsigned int e = 0U; e < 4U; e += 2U)
+        {
+            section[e] = 1U + random_below(GEN_SECTIONS);
+            section[e + 1U] = section[e] + random_below(GEN_SECTIONS + 1U - section[e]);
+        }
+        used += (size_t) sprintf(&buf[used], "%u-%u,%u-%u\n", section[0], section[1], section[2], section[3]);
+        if (used > (GEN_BUFFER_SIZE - 16U))
+        {
+            ok = (fwrite(buf, 1U, used, fp) == used);
+            used = 0U;
+        }
+    }
+    ok = ok && (fwrite(buf, 1U, used, fp) == used);
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "Could not write file %s!\n", name);
+        return EXIT_FAILURE;
+    }
 
     return EXIT_SUCCESS;
 }
+
+/* xorshift64, https://en.wikipedia.org/wiki/Xorshift */
+static unsigned int random_below(unsigned int n)
+{
+    static unsigned long long rng = 88172645463325252U;
+
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+
+    return (unsigned int)((rng >> 8) % n);
+}
+
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1)
+{
+    return (double)(t1->tv_sec - t0->tv_sec) + ((double)(t1->tv_nsec - t0->tv_nsec) / 1e9);
+}
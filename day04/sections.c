@@ -0,0 +1,248 @@
+/*
+ * Day 4 - module to parse and compare section assignments of pairs of elves.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "sections.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define MAX_DIGITS  (9U)  /* sections fit into int32_t */
+#define VECTOR_SIZE (8U)  /* pairs */
+
+static int grow(pairs_t* p);
+static int parse_pair(const char* text, size_t n, size_t* i, int32_t section[4]);
+static int line_end(const char* text, size_t n, size_t* i);
+static int parse_number(const char* text, size_t n, size_t* i, int32_t* number);
+static void count_scalar(const pairs_t* p, size_t from, counts_t* c);
+#if defined(__AVX2__)
+static size_t count_vectors(const pairs_t* p, counts_t* c);
+#endif
+
+int pairs_init(pairs_t* p, size_t size)
+{
+    p->used = 0U;
+    p->size = (size > 0U) ? size : 1U;
+    p->line = 1U;
+    for (unsigned int e = 0U; e < NUM_ELVES_; e++)
+    {
+        p->min[e] = malloc(p->size * sizeof(int32_t));
+        p->max[e] = malloc(p->size * sizeof(int32_t));
+    }
+    if (   (p->min[ELF_FIRST] == NULL) || (p->max[ELF_FIRST] == NULL)
+        || (p->min[ELF_SECOND] == NULL) || (p->max[ELF_SECOND] == NULL))
+    {
+        pairs_free(p);
+        return 0;
+    }
+
+    return 1;
+}
+
+void pairs_clear(pairs_t* p)
+{
+    p->used = 0U;
+}
+
+void pairs_free(pairs_t* p)
+{
+    for (unsigned int e = 0U; e < NUM_ELVES_; e++)
+    {
+        free(p->min[e]);
+        free(p->max[e]);
+        p->min[e] = NULL;
+        p->max[e] = NULL;
+    }
+    p->used = 0U;
+    p->size = 0U;
+}
+
+int pairs_parse(pairs_t* p, const char* text, size_t n)
+{
+    size_t i = 0U;
+    while (i < n)
+    {
+        int32_t section[4];
+        if (!parse_pair(text, n, &i, section))
+        {
+            fprintf(stderr, "Unexpected data in line %llu!", (unsigned long long) p->line);
+            return 0;
+        }
+        if ((p->used == p->size) && !grow(p))
+        {
+            fprintf(stderr, "Not enough memory!");
+            return 0;
+        }
+        p->min[ELF_FIRST][p->used] = section[0];
+        p->max[ELF_FIRST][p->used] = section[1];
+        p->min[ELF_SECOND][p->used] = section[2];
+        p->max[ELF_SECOND][p->used] = section[3];
+        p->used++;
+        p->line++;
+    }
+
+    return 1;
+}
+
+int range_parse(const char* text, size_t n, size_t* i, range_t* r)
+{
+    int32_t min;
+    int32_t max;
+    if (   !parse_number(text, n, i, &min)
+        || (*i >= n) || (text[(*i)++] != '-')
+        || !parse_number(text, n, i, &max))
+    {
+        return 0;
+    }
+    r->min = min;
+    r->max = max;
+
+    return 1;
+}
+
+int range_parse_line(const char* text, size_t n, size_t* i, range_t* r)
+{
+    return range_parse(text, n, i, r) && line_end(text, n, i);
+}
+
+void pairs_count(const pairs_t* p, counts_t* c)
+{
+#if defined(__AVX2__)
+    count_scalar(p, count_vectors(p, c), c);
+#else
+    count_scalar(p, 0U, c);
+#endif
+}
+
+void pairs_count_scalar(const pairs_t* p, counts_t* c)
+{
+    count_scalar(p, 0U, c);
+}
+
+static int grow(pairs_t* p)
+{
+    size_t size = p->size * 2U;
+    for (unsigned int e = 0U; e < NUM_ELVES_; e++)
+    {
+        int32_t* min = realloc(p->min[e], size * sizeof(int32_t));
+        if (min == NULL)
+            return 0;
+        p->min[e] = min;
+        int32_t* max = realloc(p->max[e], size * sizeof(int32_t));
+        if (max == NULL)
+            return 0;
+        p->max[e] = max;
+    }
+    p->size = size;
+
+    return 1;
+}
+
+/* "a-b,c-d" up to the line end, which is skipped */
+static int parse_pair(const char* text, size_t n, size_t* i, int32_t section[4])
+{
+    range_t r[NUM_ELVES_];
+    if (   !range_parse(text, n, i, &r[ELF_FIRST])
+        || (*i >= n) || (text[(*i)++] != ',')
+        || !range_parse(text, n, i, &r[ELF_SECOND])
+        || !line_end(text, n, i))
+    {
+        return 0;
+    }
+    section[0] = r[ELF_FIRST].min;
+    section[1] = r[ELF_FIRST].max;
+    section[2] = r[ELF_SECOND].min;
+    section[3] = r[ELF_SECOND].max;
+
+    return 1;
+}
+
+/* "\n" or "\r\n", the end of text is one as well */
+static int line_end(const char* text, size_t n, size_t* i)
+{
+    if ((*i < n) && (text[*i] == '\r'))
+        (*i)++;
+    if (*i < n)
+        return (text[(*i)++] == '\n');
+
+    return 1;
+}
+
+static int parse_number(const char* text, size_t n, size_t* i, int32_t* number)
+{
+    size_t j = *i;
+    size_t end = ((n - j) > MAX_DIGITS) ? (j + MAX_DIGITS) : n;
+    int32_t v = 0;
+    while ((j < end) && ((unsigned char)(text[j] - '0') <= 9U))
+    {
+        v = (v * 10) + (text[j] - '0');
+        j++;
+    }
+    if ((j == *i) || ((j < n) && ((unsigned char)(text[j] - '0') <= 9U)))
+        return 0;
+    *i = j;
+    *number = v;
+
+    return 1;
+}
+
+/* comparisons give 0 or 1, which are added up without branches */
+static void count_scalar(const pairs_t* p, size_t from, counts_t* c)
+{
+    const int32_t* min1 = p->min[ELF_FIRST];
+    const int32_t* max1 = p->max[ELF_FIRST];
+    const int32_t* min2 = p->min[ELF_SECOND];
+    const int32_t* max2 = p->max[ELF_SECOND];
+    unsigned long long contained = 0U;
+    unsigned long long overlap = 0U;
+
+    for (size_t i = from; i < p->used; i++)
+    {
+        contained += (unsigned int)(   ((min1[i] >= min2[i]) & (max1[i] <= max2[i]))
+                                     | ((min2[i] >= min1[i]) & (max2[i] <= max1[i])));
+        overlap += (unsigned int)((min1[i] <= max2[i]) & (min2[i] <= max1[i]));
+    }
+    c->contained += contained;
+    c->overlap += overlap;
+}
+
+#if defined(__AVX2__)
+/* compare all complete vectors of 8 pairs, returns the number of pairs done */
+static size_t count_vectors(const pairs_t* p, counts_t* c)
+{
+    unsigned long long contained = 0U;
+    unsigned long long overlap = 0U;
+    size_t n = p->used - (p->used % VECTOR_SIZE);
+
+    for (size_t i = 0U; i < n; i += VECTOR_SIZE)
+    {
+        __m256i min1 = _mm256_loadu_si256((const __m256i*) &p->min[ELF_FIRST][i]);
+        __m256i max1 = _mm256_loadu_si256((const __m256i*) &p->max[ELF_FIRST][i]);
+        __m256i min2 = _mm256_loadu_si256((const __m256i*) &p->min[ELF_SECOND][i]);
+        __m256i max2 = _mm256_loadu_si256((const __m256i*) &p->max[ELF_SECOND][i]);
+
+        /* lanes of all bits set where the first is outside of the second and vice versa */
+        __m256i first_out = _mm256_or_si256(_mm256_cmpgt_epi32(min2, min1), _mm256_cmpgt_epi32(max1, max2));
+        __m256i second_out = _mm256_or_si256(_mm256_cmpgt_epi32(min1, min2), _mm256_cmpgt_epi32(max2, max1));
+        __m256i apart = _mm256_or_si256(_mm256_cmpgt_epi32(min1, max2), _mm256_cmpgt_epi32(min2, max1));
+
+        unsigned int both_out = (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(first_out, second_out)));
+        unsigned int disjoint = (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(apart));
+        contained += VECTOR_SIZE - (unsigned int) __builtin_popcount(both_out);
+        overlap += VECTOR_SIZE - (unsigned int) __builtin_popcount(disjoint);
+    }
+    c->contained += contained;
+    c->overlap += overlap;
+
+    return n;
+}
+#endif
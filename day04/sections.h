@@ -0,0 +1,75 @@
+/*
+ * Day 4 - module to parse and compare section assignments of pairs of elves.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef SECTIONS_H_
+#define SECTIONS_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+enum
+{
+    ELF_FIRST = 0,
+    ELF_SECOND,
+    NUM_ELVES_
+};
+
+typedef struct
+{
+    int min;
+    int max;
+} range_t;
+
+/* pairs as structure of arrays, element i of all four arrays is line i */
+typedef struct
+{
+    int32_t* min[NUM_ELVES_];
+    int32_t* max[NUM_ELVES_];
+    size_t used;
+    size_t size;
+    size_t line;    /* number of the next line, starting at 1 */
+} pairs_t;
+
+typedef struct
+{
+    unsigned long long contained;   /* pairs with one range containing the other */
+    unsigned long long overlap;     /* pairs of overlapping ranges */
+} counts_t;
+
+/* allocate room for size pairs, returns 0 if there is not enough memory */
+int pairs_init(pairs_t* p, size_t size);
+
+/* forget the pairs, but keep counting lines */
+void pairs_clear(pairs_t* p);
+
+void pairs_free(pairs_t* p);
+
+/*
+ * Append the pairs "a-b,c-d" of complete lines, the last one may lack its line
+ * end. The arrays grow as needed. Returns 0 on unexpected data, the line is
+ * reported on stderr, or if there is not enough memory.
+ */
+int pairs_parse(pairs_t* p, const char* text, size_t n);
+
+/* parse the range "a-b" at text[*i], *i is advanced behind it */
+int range_parse(const char* text, size_t n, size_t* i, range_t* r);
+
+/* same as range_parse() for a line, its end "\n" or "\r\n" is skipped as well */
+int range_parse_line(const char* text, size_t n, size_t* i, range_t* r);
+
+/*
+ * Add the pairs of contained and overlapping ranges without branches. If built
+ * with AVX2, 8 pairs are compared at once.
+ */
+void pairs_count(const pairs_t* p, counts_t* c);
+
+/* same as pairs_count() pair by pair, as reference */
+void pairs_count_scalar(const pairs_t* p, counts_t* c);
+
+#endif /* SECTIONS_H_ */
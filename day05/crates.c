@@ -0,0 +1,201 @@
+/*
+ * Day 5 - module for stacks of crates of any height and number.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "crates.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#define MIN_CAPACITY (16U)
+
+static int reserve(crates_t* c, size_t size);
+static int check_move(stacks_t* s, size_t num, size_t from, size_t to);
+
+void stacks_init(stacks_t* s)
+{
+    s->stack = NULL;
+    s->num = 0U;
+    s->capacity = 0U;
+}
+
+void stacks_free(stacks_t* s)
+{
+    for (size_t i = 0U; i < s->capacity; i++)
+        free(s->stack[i].data);
+    free(s->stack);
+    stacks_init(s);
+}
+
+int stacks_resize(stacks_t* s, size_t num)
+{
+    if (num > s->capacity)
+    {
+        crates_t* stack = realloc(s->stack, num * sizeof(crates_t));
+        if (stack == NULL)
+            return 0;
+        for (size_t i = s->capacity; i < num; i++)
+        {
+            stack[i].data = NULL;
+            stack[i].capacity = 0U;
+        }
+        s->stack = stack;
+        s->capacity = num;
+    }
+    for (size_t i = s->num; i < num; i++)
+        s->stack[i].size = 0U;
+    s->num = num;
+
+    return 1;
+}
+
+int stacks_copy(stacks_t* dst, const stacks_t* src)
+{
+    if (!stacks_resize(dst, 0U) || !stacks_resize(dst, src->num))
+        return 0;
+
+    for (size_t i = 0U; i < src->num; i++)
+    {
+        if (!reserve(&dst->stack[i], src->stack[i].size))
+            return 0;
+        if (src->stack[i].size > 0U)
+            memcpy(dst->stack[i].data, src->stack[i].data, src->stack[i].size);
+        dst->stack[i].size = src->stack[i].size;
+    }
+
+    return 1;
+}
+
+int crates_push(crates_t* c, char crate)
+{
+    if (!reserve(c, c->size + 1U))
+        return 0;
+
+    c->data[c->size++] = crate;
+
+    return 1;
+}
+
+void crates_reverse(crates_t* c)
+{
+    for (size_t i = 0U, j = c->size; (i + 1U) < j; i++, j--)
+    {
+        char crate = c->data[i];
+        c->data[i] = c->data[j - 1U];
+        c->data[j - 1U] = crate;
+    }
+}
+
+int stacks_move(stacks_t* s, size_t num, size_t from, size_t to, crane_t crane)
+{
+    if (!check_move(s, num, from, to))
+        return 0;
+    if (from == to)
+        return 1;
+
+    crates_t* src = &s->stack[from];
+    crates_t* dst = &s->stack[to];
+    src->size -= num;
+    if (crane == MOVE_AT_ONCE)
+        memcpy(&dst->data[dst->size], &src->data[src->size], num);
+    else
+        crates_copy_reversed(&dst->data[dst->size], &src->data[src->size], num);
+    dst->size += num;
+
+    return 1;
+}
+
+int stacks_move_scalar(stacks_t* s, size_t num, size_t from, size_t to, crane_t crane)
+{
+    if (!check_move(s, num, from, to))
+        return 0;
+    if (from == to)
+        return 1;
+
+    crates_t* src = &s->stack[from];
+    crates_t* dst = &s->stack[to];
+    src->size -= num;
+    for (size_t i = 0U; i < num; i++)
+    {
+        size_t k = (crane == MOVE_AT_ONCE) ? i : (num - 1U - i);
+        dst->data[dst->size++] = src->data[src->size + k];
+    }
+
+    return 1;
+}
+
+void crates_copy_reversed(char* dst, const char* src, size_t n)
+{
+    size_t i = 0U;
+
+#if defined(__AVX2__)
+    /* reverse the bytes of both lanes, then swap the lanes */
+    const __m256i reversed = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                              15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    for (; (n - i) >= 32U; i += 32U)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) &src[n - i - 32U]);
+        v = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, reversed), 0x4E);
+        _mm256_storeu_si256((__m256i*) &dst[i], v);
+    }
+#elif defined(__SSSE3__)
+    const __m128i reversed = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    for (; (n - i) >= 16U; i += 16U)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &src[n - i - 16U]);
+        _mm_storeu_si128((__m128i*) &dst[i], _mm_shuffle_epi8(v, reversed));
+    }
+#endif
+
+#if defined(__GNUC__)
+    for (; (n - i) >= 8U; i += 8U)
+    {
+        uint64_t w;
+        memcpy(&w, &src[n - i - 8U], 8U);
+        w = __builtin_bswap64(w);
+        memcpy(&dst[i], &w, 8U);
+    }
+#endif
+
+    for (; i < n; i++)
+        dst[i] = src[n - 1U - i];
+}
+
+/* stacks exist, enough crates and room for them */
+static int check_move(stacks_t* s, size_t num, size_t from, size_t to)
+{
+    if ((from >= s->num) || (to >= s->num) || (num > s->stack[from].size))
+        return 0;
+
+    return reserve(&s->stack[to], s->stack[to].size + num);
+}
+
+/* room for size crates, the capacity doubles to keep pushing cheap */
+static int reserve(crates_t* c, size_t size)
+{
+    if (size <= c->capacity)
+        return 1;
+
+    size_t capacity = (c->capacity > 0U) ? c->capacity : MIN_CAPACITY;
+    while (capacity < size)
+        capacity *= 2U;
+
+    char* data = realloc(c->data, capacity);
+    if (data == NULL)
+        return 0;
+    c->data = data;
+    c->capacity = capacity;
+
+    return 1;
+}
@@ -0,0 +1,74 @@
+/*
+ * Day 5 - module for stacks of crates of any height and number.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef CRATES_H_
+#define CRATES_H_
+
+#include <stdlib.h>
+
+/* crates of a stack, bottom first */
+typedef struct
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+} crates_t;
+
+/* memory of the stacks only grows, so they can be reused for many inputs */
+typedef struct
+{
+    crates_t* stack;
+    size_t num;         /* stacks in use */
+    size_t capacity;    /* stacks allocated */
+} stacks_t;
+
+typedef enum
+{
+    MOVE_ONE_BY_ONE,    /* CrateMover 9000: the moved crates end up reversed */
+    MOVE_AT_ONCE        /* CrateMover 9001: the moved crates keep their order */
+} crane_t;
+
+/* no stacks, nothing is allocated */
+void stacks_init(stacks_t* s);
+
+void stacks_free(stacks_t* s);
+
+/*
+ * Use num stacks, the crates of stacks in use before are kept, others start
+ * empty. Returns 0 if there is not enough memory.
+ */
+int stacks_resize(stacks_t* s, size_t num);
+
+/* copy all stacks of src, returns 0 if there is not enough memory */
+int stacks_copy(stacks_t* dst, const stacks_t* src);
+
+/* put a crate on top of a stack, returns 0 if there is not enough memory */
+int crates_push(crates_t* c, char crate);
+
+/* turn a stack upside down */
+void crates_reverse(crates_t* c);
+
+/*
+ * Move num crates from one stack to another, both counted from 0. Returns 0
+ * if there is no such stack or not enough crates, or not enough memory. The
+ * crates are copied as a block, reversed by crates_copy_reversed() if moved
+ * one by one.
+ */
+int stacks_move(stacks_t* s, size_t num, size_t from, size_t to, crane_t crane);
+
+/* same as stacks_move() crate by crate, as reference */
+int stacks_move_scalar(stacks_t* s, size_t num, size_t from, size_t to, crane_t crane);
+
+/*
+ * Copy n crates in reverse order, src and dst must not overlap. Long runs are
+ * reversed 32 bytes at once with AVX2, 16 with SSSE3 or 8 by byte swaps.
+ */
+void crates_copy_reversed(char* dst, const char* src, size_t n);
+
+#endif /* CRATES_H_ */
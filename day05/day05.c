@@ -0,0 +1,407 @@
+/*
+ * Solver for advent of code 2022 day 5.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day05.h"
+
+#include "crates.h"
+#include "rope.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_LINE_SIZE (64U) /* lines grow as needed */
+#define COLUMN_WIDTH  (4U)  /* "[A] " */
+#define LOG_STACKS    (64U)
+#define LOG_CRATES    (64U)
+
+typedef enum
+{
+    READ_STACKS,
+    MOVE_DATA
+} parsing_t;
+
+typedef struct
+{
+    char* line;
+    size_t line_size;
+    char* top;
+    size_t top_size;
+    stacks_t stacks[SOLVER_NUM_PARTS];
+    ropes_t ropes[SOLVER_NUM_PARTS];
+} state_t;
+
+static int use_ropes = 0;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+static int read_line(state_t* s, FILE* fp, size_t* length);
+static int grow_line(state_t* s);
+static int read_crates(stacks_t* stacks, const char* line, size_t length);
+static int read_labels(const char* line, size_t length, size_t* num);
+static int start_moving(state_t* s, size_t labels, FILE* log);
+static void print_stacks(FILE* log, const stacks_t* stacks);
+static int move(state_t* s, size_t num, size_t from, size_t to);
+static int top_crates(state_t* s, size_t part, FILE* log, solver_result_t* result);
+
+const solver_t day05_solver =
+{
+    .name = "day05",
+    .title = "Day 5: Supply Stacks",
+    .part =
+    {
+        "Final string",
+        "Final string"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+void day05_use_ropes(int ropes)
+{
+    use_ropes = ropes;
+}
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->line_size = MIN_LINE_SIZE;
+    s->line = malloc(s->line_size);
+    s->top_size = MIN_LINE_SIZE;
+    s->top = malloc(s->top_size);
+    if ((s->line == NULL) || (s->top == NULL))
+    {
+        free(s->line);
+        free(s->top);
+        free(s);
+        return NULL;
+    }
+    for (size_t p = 0U; p < SOLVER_NUM_PARTS; p++)
+    {
+        stacks_init(&s->stacks[p]);
+        ropes_init(&s->ropes[p]);
+    }
+
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    stacks_t* p1 = &s->stacks[0];
+
+    if (!stacks_resize(p1, 0U))
+        return 0;
+
+    unsigned long long line = 1U;
+    size_t labels = 0U;
+    size_t length;
+    parsing_t parsing = READ_STACKS;
+    for (;;)
+    {
+        if (!read_line(s, fp, &length))
+            return 0;
+        if (length == 0U)
+            break;
+
+        /* line end is not needed */
+        s->line[--length] = '\0';
+        if ((length > 0U) && (s->line[length - 1U] == '\r'))
+            s->line[--length] = '\0';
+
+        switch (parsing)
+        {
+            case READ_STACKS:
+                /* use empty line to switch from initial stack to move operations */
+                if (length == 0U)
+                {
+                    if (!start_moving(s, labels, log))
+                        return 0;
+                    parsing = MOVE_DATA;
+                }
+                else if (labels > 0U)
+                {
+                    fprintf(stderr, "Unexpected data in line %llu!", line);
+                    return 0;
+                }
+                else if (strchr(s->line, '[') != NULL)
+                {
+                    if (!read_crates(p1, s->line, length))
+                    {
+                        fprintf(stderr, "Not enough memory!");
+                        return 0;
+                    }
+                }
+                else if (!read_labels(s->line, length, &labels))
+                {
+                    fprintf(stderr, "Unexpected stack numbers in line %llu!", line);
+                    return 0;
+                }
+                break;
+            case MOVE_DATA:
+                {
+                    unsigned long long num, from, to;
+                    if (sscanf(s->line, "move %llu from %llu to %llu", &num, &from, &to) != 3)
+                    {
+                        fprintf(stderr, "Unexpected data in line %llu!", line);
+                        return 0;
+                    }
+                    if (   (from == 0U) || (to == 0U)
+                        || !move(s, (size_t) num, (size_t) from - 1U, (size_t) to - 1U))
+                    {
+                        fprintf(stderr, "Invalid move in line %llu!", line);
+                        return 0;
+                    }
+                }
+                break;
+            default:
+                fprintf(stderr, "Unexpected state");
+                return 0;
+        }
+        line++;
+    }
+    if ((parsing == READ_STACKS) && !start_moving(s, labels, log)) /* no moves */
+        return 0;
+
+    solver_log(log, "\n");
+
+    return    top_crates(s, 1U, log, result)
+           && top_crates(s, 2U, log, result);
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    for (size_t p = 0U; p < SOLVER_NUM_PARTS; p++)
+    {
+        stacks_free(&s->stacks[p]);
+        ropes_free(&s->ropes[p]);
+    }
+    free(s->line);
+    free(s->top);
+    free(s);
+}
+
+/*
+ * Read a line of any length incl. its line end, the last one gets one if it
+ * lacks it. Its length is 0 at the end of the input. Returns 0 on errors.
+ */
+static int read_line(state_t* s, FILE* fp, size_t* length)
+{
+    size_t n = 0U;
+    while (fgets(&s->line[n], (int)(s->line_size - n), fp) != NULL)
+    {
+        n += strlen(&s->line[n]);
+        if ((n > 0U) && (s->line[n - 1U] == '\n'))
+        {
+            *length = n;
+            return 1;
+        }
+        if (((n + 2U) >= s->line_size) && !grow_line(s))
+            return 0;
+    }
+    if (ferror(fp))
+    {
+        fprintf(stderr, "Could not read input!");
+        return 0;
+    }
+
+    /* fgets() left room for a line end */
+    if (n > 0U)
+    {
+        s->line[n++] = '\n';
+        s->line[n] = '\0';
+    }
+    *length = n;
+
+    return 1;
+}
+
+static int grow_line(state_t* s)
+{
+    char* grown = realloc(s->line, s->line_size * 2U);
+    if (grown == NULL)
+    {
+        fprintf(stderr, "Not enough memory!");
+        return 0;
+    }
+    s->line = grown;
+    s->line_size *= 2U;
+
+    return 1;
+}
+
+/* crates "[A]" of a row of the drawing, stacks are added as needed */
+static int read_crates(stacks_t* stacks, const char* line, size_t length)
+{
+    for (size_t i = 1U, n = 0U; i < length; i += COLUMN_WIDTH, n++)
+    {
+        if ((line[i] < 'A') || (line[i] > 'Z'))
+            continue;
+        if ((n >= stacks->num) && !stacks_resize(stacks, n + 1U))
+            return 0;
+        if (!crates_push(&stacks->stack[n], line[i]))
+            return 0;
+    }
+
+    return 1;
+}
+
+/* stack numbers " 1   2   3 " below the drawing, they have to be in order */
+static int read_labels(const char* line, size_t length, size_t* num)
+{
+    size_t n = 0U;
+    size_t i = 0U;
+    while (i < length)
+    {
+        if (line[i] == ' ')
+        {
+            i++;
+            continue;
+        }
+
+        unsigned long long label = 0U;
+        while ((i < length) && (line[i] >= '0') && (line[i] <= '9'))
+            label = (label * 10U) + (unsigned long long)(line[i++] - '0');
+        if ((i < length) && (line[i] != ' '))
+            return 0;
+        if (label != (n + 1U))
+            return 0;
+        n++;
+    }
+    *num = n;
+
+    return (n > 0U);
+}
+
+/*
+ * The drawing is read top down, so the stacks are turned for the moves. Both
+ * parts start from a copy, ropes are loaded from the stacks of part 1.
+ */
+static int start_moving(state_t* s, size_t labels, FILE* log)
+{
+    stacks_t* p1 = &s->stacks[0];
+
+    if (labels < p1->num)
+    {
+        fprintf(stderr, "Crates without stack number!");
+        return 0;
+    }
+    if (!stacks_resize(p1, labels))
+    {
+        fprintf(stderr, "Not enough memory!");
+        return 0;
+    }
+    for (size_t i = 0U; i < p1->num; i++)
+        crates_reverse(&p1->stack[i]);
+
+    solver_log(log, "initial stacks:\n");
+    print_stacks(log, p1);
+
+    int ok;
+    if (use_ropes)
+        ok = ropes_load(&s->ropes[0], p1) && ropes_load(&s->ropes[1], p1);
+    else
+        ok = stacks_copy(&s->stacks[1], p1);
+    if (!ok)
+    {
+        fprintf(stderr, "Not enough memory!");
+        return 0;
+    }
+
+    return 1;
+}
+
+/* only the bottom of the first stacks, they may be huge */
+static void print_stacks(FILE* log, const stacks_t* stacks)
+{
+    for (size_t i = 0U; (i < stacks->num) && (i < LOG_STACKS); i++)
+    {
+        size_t size = stacks->stack[i].size;
+        solver_log(log, "#%llu: [%llu] %.*s%s\n", (unsigned long long) i, (unsigned long long) size,
+                   (int)((size < LOG_CRATES) ? size : LOG_CRATES), stacks->stack[i].data,
+                   (size > LOG_CRATES) ? "..." : "");
+    }
+    if (stacks->num > LOG_STACKS)
+        solver_log(log, "...\n");
+}
+
+/* crate mover 9000 for part 1 and 9001 for part 2 */
+static int move(state_t* s, size_t num, size_t from, size_t to)
+{
+    if (use_ropes)
+    {
+        return    ropes_move(&s->ropes[0], num, from, to, MOVE_ONE_BY_ONE)
+               && ropes_move(&s->ropes[1], num, from, to, MOVE_AT_ONCE);
+    }
+
+    return    stacks_move(&s->stacks[0], num, from, to, MOVE_ONE_BY_ONE)
+           && stacks_move(&s->stacks[1], num, from, to, MOVE_AT_ONCE);
+}
+
+/*
+ * Collect top most crate of each stack, empty stacks are skipped. If there are
+ * too many for an answer, it is their number and hash, the crates are logged.
+ */
+static int top_crates(state_t* s, size_t part, FILE* log, solver_result_t* result)
+{
+    const stacks_t* stacks = &s->stacks[part - 1U];
+    const ropes_t* ropes = &s->ropes[part - 1U];
+    size_t num = use_ropes ? ropes->num : stacks->num;
+    if (num >= s->top_size)
+    {
+        char* grown = realloc(s->top, num + 1U);
+        if (grown == NULL)
+        {
+            fprintf(stderr, "Not enough memory!");
+            return 0;
+        }
+        s->top = grown;
+        s->top_size = num + 1U;
+    }
+
+    size_t n = 0U;
+    for (size_t i = 0U; i < num; i++)
+    {
+        if (use_ropes)
+        {
+            if (ropes->rope[i].size > 0U)
+                s->top[n++] = rope_top(&ropes->rope[i]);
+        }
+        else if (stacks->stack[i].size > 0U)
+        {
+            s->top[n++] = stacks->stack[i].data[stacks->stack[i].size - 1U];
+        }
+    }
+    s->top[n] = '\0';
+
+    if (n < SOLVER_ANSWER_SIZE)
+    {
+        solver_answer(result, part, "%s", s->top);
+        return 1;
+    }
+
+    /* FNV-1a, https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function */
+    unsigned long long hash = 14695981039346656037U;
+    for (size_t i = 0U; i < n; i++)
+    {
+        hash ^= (unsigned char) s->top[i];
+        hash *= 1099511628211U;
+    }
+    solver_log(log, "part %llu: %s\n", (unsigned long long) part, s->top);
+    solver_answer(result, part, "%llu crates, FNV-1a %016llx", (unsigned long long) n, hash);
+
+    return 1;
+}
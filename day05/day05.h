@@ -0,0 +1,27 @@
+/*
+ * Solver for advent of code 2022 day 5.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY05_H_
+#define DAY05_H_
+
+#include "solver.h"
+
+extern const solver_t day05_solver;
+
+/**
+ * \brief Select how the crates are moved.
+ *
+ * Applies to the following inputs, so it must be set before solving.
+ *
+ * \param[in] ropes 0 to copy crates between stacks, else to move pieces of
+ *                  ropes of shared chunks.
+ */
+void day05_use_ropes(int ropes);
+
+#endif /* DAY05_H_ */
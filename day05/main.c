@@ -7,170 +7,320 @@
  * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
  */
 
+/*
+ * Besides the options of all days, this program accepts:
+ *
+ *   -g stacks height moves file  generate an input of stacks of the given
+ *                                height and random moves of 1 up to all
+ *                                crates of a stack
+ *   -k crates                    benchmark of moving the given number of
+ *                                crates crate by crate vs. as a block vs.
+ *                                as pieces of ropes
+ *   -r                           move pieces of ropes instead of copying
+ *                                crates between stacks
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "day05.h"
+#include "crates.h"
+#include "rope.h"
+
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-#define MAX_LINE_SIZE   (64U)  /* max line length of input file */
-#define MAX_STACK_SIZE  (100U) /* max size of a stack */
-#define NUM_STACKS      (9U)   /* (max) number of stacks*/
+#define BENCH_REPETITIONS (5U)
+#define BENCH_CRATES      (67108864U) /* moved crates of each run */
+#define GEN_BUFFER_SIZE   (65536U)
 
-typedef enum
-{
-    READ_STACKS,
-    MOVE_DATA
-} state_t;
+typedef int (*move_t)(stacks_t* s, size_t num, size_t from, size_t to, crane_t crane);
 
-typedef struct
-{
-    size_t size;
-    char data[MAX_STACK_SIZE];
-} stack_t;
+static int run_kernels(size_t crates);
+static double time_kernel(move_t move, crane_t crane, size_t crates, stacks_t* s);
+static double time_ropes(crane_t crane, size_t crates, stacks_t* s, ropes_t* r);
+static int fill(stacks_t* s, size_t crates);
+static int generate(const char* name, size_t stacks, size_t height, unsigned long long moves);
+static int write_drawing(FILE* fp, size_t stacks, size_t height);
+static size_t random_below(size_t n);
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1);
 
-typedef struct
+int main(int argc, char *argv[])
 {
-    int from;
-    int to;
-    int num;
-} move_t;
+    /* day specific options are handled here, other arguments are passed on */
+    int args = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-g") == 0)
+        {
+            unsigned long long stacks, height, moves;
+            if (   ((i + 4) >= argc)
+                || (sscanf(argv[i + 1], "%llu", &stacks) != 1)
+                || (sscanf(argv[i + 2], "%llu", &height) != 1)
+                || (sscanf(argv[i + 3], "%llu", &moves) != 1)
+                || (stacks == 0U)
+                || (height == 0U))
+            {
+                fprintf(stderr, "Invalid number of stacks, height, moves or file name!\n");
+                return EXIT_FAILURE;
+            }
+            return generate(argv[i + 4], (size_t) stacks, (size_t) height, moves);
+        }
+        else if (strcmp(argv[i], "-k") == 0)
+        {
+            unsigned long long crates;
+            if (   ((i + 1) >= argc)
+                || (sscanf(argv[i + 1], "%llu", &crates) != 1)
+                || (crates == 0U))
+            {
+                fprintf(stderr, "Invalid number of crates!\n");
+                return EXIT_FAILURE;
+            }
+            return run_kernels((size_t) crates);
+        }
+        else if (strcmp(argv[i], "-r") == 0)
+        {
+            day05_use_ropes(1);
+        }
+        else
+        {
+            argv[args++] = argv[i];
+        }
+    }
+    argv[args] = NULL;
 
-void print_stacks(const stack_t stacks[]);
-void reverse(char s[]);
+    return solver_main(&day05_solver, args, argv);
+}
 
-int main(int argc, char *argv[])
+static int run_kernels(size_t crates)
 {
-    printf("Advent of Code 2022 - Day 5: Supply Stacks\n\n");
+    static const char* const cranes[] = { "one by one", "at once" };
+    stacks_t scalar;
+    stacks_t block;
+    stacks_t start;
+    ropes_t ropes;
+    char* crates_of_rope = malloc(crates);
+    int ok = (crates_of_rope != NULL);
 
-    if (argc != 2)
+    stacks_init(&scalar);
+    stacks_init(&block);
+    stacks_init(&start);
+    ropes_init(&ropes);
+    for (unsigned int crane = MOVE_ONE_BY_ONE; ok && (crane <= MOVE_AT_ONCE); crane++)
     {
-        fprintf(stderr, "Please provide data record file name.");
-        exit(EXIT_FAILURE);
+        double scalar_s = time_kernel(stacks_move_scalar, (crane_t) crane, crates, &scalar);
+        double block_s = time_kernel(stacks_move, (crane_t) crane, crates, &block);
+        double rope_s = time_ropes((crane_t) crane, crates, &start, &ropes);
+        ok = (scalar_s >= 0.0) && (block_s >= 0.0) && (rope_s >= 0.0);
+        if (!ok)
+            break;
+        for (size_t i = 0U; ok && (i < scalar.num); i++)
+        {
+            ok =    (scalar.stack[i].size == block.stack[i].size)
+                 && (memcmp(scalar.stack[i].data, block.stack[i].data, scalar.stack[i].size) == 0)
+                 && (scalar.stack[i].size == ropes.rope[i].size);
+            if (ok)
+            {
+                rope_copy(&ropes.rope[i], crates_of_rope);
+                ok = (memcmp(scalar.stack[i].data, crates_of_rope, scalar.stack[i].size) == 0);
+            }
+        }
+        if (!ok)
+        {
+            fprintf(stderr, "Stacks of scalar, block and rope moves differ!\n");
+            break;
+        }
+
+        printf("moves of %llu crates %s:\n", (unsigned long long) crates, cranes[crane]);
+        printf("scalar %9.1f M crates/s\n", ((double) BENCH_CRATES / scalar_s) / 1e6);
+        printf("block  %9.1f M crates/s\n", ((double) BENCH_CRATES / block_s) / 1e6);
+        printf("rope   %9.1f M crates/s\n", ((double) BENCH_CRATES / rope_s) / 1e6);
     }
+    if (crates_of_rope == NULL)
+        fprintf(stderr, "Not enough memory!\n");
+    free(crates_of_rope);
+    stacks_free(&scalar);
+    stacks_free(&block);
+    stacks_free(&start);
+    ropes_free(&ropes);
 
-    FILE* fp = fopen(argv[1], "r");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
 
-    if (!fp)
+/*
+ * Fastest of some runs of moving the crates between two stacks back and forth,
+ * or -1 if there is not enough memory. The stacks are left after the last run.
+ */
+static double time_kernel(move_t move, crane_t crane, size_t crates, stacks_t* s)
+{
+    size_t moves = (BENCH_CRATES + crates - 1U) / crates;
+    double best = 0.0;
+    for (unsigned int rep = 0U; rep < BENCH_REPETITIONS; rep++)
     {
-        fprintf(stderr, "Could not open file!");
-        exit(EXIT_FAILURE);
+        if (!fill(s, crates))
+            return -1.0;
+
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (size_t m = 0U; m < moves; m++)
+        {
+            if (!move(s, crates, m % 2U, (m + 1U) % 2U, crane))
+            {
+                fprintf(stderr, "Not enough memory!\n");
+                return -1.0;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double t = elapsed_s(&t0, &t1) * ((double) BENCH_CRATES / (double)(moves * crates));
+        if ((rep == 0U) || (t < best))
+            best = t;
     }
 
-    int line = 0;
-    char line_buf[MAX_LINE_SIZE];
-    stack_t stacks_p1[NUM_STACKS] = {0};
-    stack_t stacks_p2[NUM_STACKS] = {0};
-    state_t state = READ_STACKS;
-    while (fgets(line_buf, MAX_LINE_SIZE, fp))
+    return best;
+}
+
+/* the same moves by ropes, loaded from stacks s */
+static double time_ropes(crane_t crane, size_t crates, stacks_t* s, ropes_t* r)
+{
+    size_t moves = (BENCH_CRATES + crates - 1U) / crates;
+    double best = 0.0;
+    for (unsigned int rep = 0U; rep < BENCH_REPETITIONS; rep++)
     {
-        /* use empty line to switch from initial stack to move operations */
-        if (line_buf[0] == '\n')
+        if (!fill(s, crates))
+            return -1.0;
+        if (!ropes_load(r, s))
         {
-            state = MOVE_DATA;
-            /* reverse stack data to have top most element as last char in string */
-            for (size_t s = 0U; s < NUM_STACKS; s++)
+            fprintf(stderr, "Not enough memory!\n");
+            return -1.0;
+        }
+
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (size_t m = 0U; m < moves; m++)
+        {
+            if (!ropes_move(r, crates, m % 2U, (m + 1U) % 2U, crane))
             {
-                if (stacks_p1[s].size > 0)
-                    reverse(stacks_p1[s].data);
+                fprintf(stderr, "Not enough memory!\n");
+                return -1.0;
             }
-            printf("initial stacks:\n");
-            print_stacks(stacks_p1);
-            memcpy(stacks_p2, stacks_p1, sizeof(stacks_p2));
-            continue; /* skip processing of empty line */
         }
-        switch (state)
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double t = elapsed_s(&t0, &t1) * ((double) BENCH_CRATES / (double)(moves * crates));
+        if ((rep == 0U) || (t < best))
+            best = t;
+    }
+
+    return best;
+}
+
+/* two stacks, the first of the given number of crates */
+static int fill(stacks_t* s, size_t crates)
+{
+    if (!stacks_resize(s, 0U) || !stacks_resize(s, 2U))
+    {
+        fprintf(stderr, "Not enough memory!\n");
+        return 0;
+    }
+    for (size_t i = 0U; i < crates; i++)
+    {
+        if (!crates_push(&s->stack[0], (char)('A' + (i % 26U))))
         {
-            case READ_STACKS:
-                {
-                    int n = 0;
-                    size_t i = 1U;
-                    size_t max = strlen(line_buf);
-                    while (i < max)
-                    {
-                        if (line_buf[i] >= 'A' && line_buf[i] <= 'Z')
-                        {
-                            if (stacks_p1[n].size < MAX_STACK_SIZE)
-                            {
-                                stacks_p1[n].data[stacks_p1[n].size] = line_buf[i];
-                                stacks_p1[n].size++;
-                            }
-                            else
-                            {
-                                fprintf(stderr, "Too much data, increase max size of stack!");
-                                exit(EXIT_FAILURE);
-                            }
-                        }
-                        n++;
-                        i += 4;
-                    }
-                }
-                break;
-            case MOVE_DATA:
-                {
-                    move_t move = {0};
-                    if (sscanf(line_buf, "move %d from %d to %d", &move.num, &move.from, &move.to) == 3)
-                    {
-                        /* TODO: sanity checks to avoid invalid array indexes */
-                        move.from--;
-                        move.to--;
-                        for (int i = 0; i < move.num; i++)
-                        {
-                            stacks_p1[move.from].size--;
-                            stacks_p1[move.to].data[stacks_p1[move.to].size] = stacks_p1[move.from].data[stacks_p1[move.from].size];
-                            stacks_p1[move.to].size++;
-                        }
-                        stacks_p2[move.from].size -= move.num;
-                        memcpy(&stacks_p2[move.to].data[stacks_p2[move.to].size], &stacks_p2[move.from].data[stacks_p2[move.from].size], move.num);
-                        stacks_p2[move.to].size += move.num;
-                    }
-                    else
-                    {
-                        fprintf(stderr, "Unexpected data in line %d!", line);
-                        exit(EXIT_FAILURE);
-                    }
-                }
-                break;
-            default:
-                fprintf(stderr, "Unexpected state");
-                exit(EXIT_FAILURE);
+            fprintf(stderr, "Not enough memory!\n");
+            return 0;
         }
-        line++;
     }
 
-    printf("\nPart 1: Final string = ");
-    for (size_t s = 0U; s < NUM_STACKS; s++)
+    return 1;
+}
+
+/* reproducible by a fixed seed */
+static int generate(const char* name, size_t stacks, size_t height, unsigned long long moves)
+{
+    size_t* size = malloc(stacks * sizeof(size_t));
+    if (size == NULL)
     {
-        printf("%c", stacks_p1[s].data[stacks_p1[s].size-1]);
+        fprintf(stderr, "Not enough memory!\n");
+        return EXIT_FAILURE;
     }
-    printf("\nPart 2: Final string = ");
-    for (size_t s = 0U; s < NUM_STACKS; s++)
+    for (size_t i = 0U; i < stacks; i++)
+        size[i] = height;
+
+    FILE* fp = fopen(name, "wb");
+    if (fp == NULL)
     {
-        printf("%c", stacks_p2[s].data[stacks_p2[s].size-1]);
+        fprintf(stderr, "Could not open file %s!\n", name);
+        free(size);
+        return EXIT_FAILURE;
     }
-    printf("\n");
 
-    fclose(fp);
+    int ok = write_drawing(fp, stacks, height);
+    for (unsigned long long m = 0U; ok && (m < moves); m++)
+    {
+        /* there is always a stack with crates */
+        size_t from;
+        do
+        {
+            from = random_below(stacks);
+        } while (size[from] == 0U);
+        size_t to = random_below(stacks);
+        size_t num = 1U + random_below(size[from]);
+
+        size[from] -= num;
+        size[to] += num;
+        ok = (fprintf(fp, "move %llu from %llu to %llu\n", (unsigned long long) num,
+                      (unsigned long long) from + 1U, (unsigned long long) to + 1U) > 0);
+    }
+    free(size);
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "Could not write file %s!\n", name);
+        return EXIT_FAILURE;
+    }
 
     return EXIT_SUCCESS;
 }
 
-void print_stacks(const stack_t stacks[])
+/* rows of random crates top down, the stack numbers and an empty line */
+static int write_drawing(FILE* fp, size_t stacks, size_t height)
 {
-    for (size_t s = 0U; s < NUM_STACKS; s++)
+    static char buf[GEN_BUFFER_SIZE];
+    size_t used = 0U;
+    int ok = 1;
+    for (size_t row = 0U; ok && (row <= height); row++)
     {
-        printf("#%lld: [%lld] %s\n", s, stacks[s].size, stacks[s].data);
+        for (size_t i = 0U; ok && (i < stacks); i++)
+        {
+            if (row < height)
+                used += (size_t) sprintf(&buf[used], "[%c]", 'A' + (int) random_below(26U));
+            else
+                used += (size_t) sprintf(&buf[used], " %llu ", (unsigned long long) i + 1U);
+            buf[used++] = ((i + 1U) < stacks) ? ' ' : '\n';
+            if (used > (GEN_BUFFER_SIZE - 32U))
+            {
+                ok = (fwrite(buf, 1U, used, fp) == used);
+                used = 0U;
+            }
+        }
     }
+    ok = ok && (fwrite(buf, 1U, used, fp) == used);
+
+    return ok && (fputc('\n', fp) != EOF);
 }
 
-void reverse(char s[])
+/* xorshift64, https://en.wikipedia.org/wiki/Xorshift */
+static size_t random_below(size_t n)
 {
-    size_t length = strlen(s);
-    char c;
-    size_t i, j;
+    static unsigned long long rng = 88172645463325252U;
 
-    for (i = 0U, j = length - 1U; i < j; i++, j--)
-    {
-        c = s[i];
-        s[i] = s[j];
-        s[j] = c;
-    }
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+
+    return (size_t)((rng >> 8) % n);
+}
+
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1)
+{
+    return (double)(t1->tv_sec - t0->tv_sec) + ((double)(t1->tv_nsec - t0->tv_nsec) / 1e9);
 }
@@ -0,0 +1,287 @@
+/*
+ * Day 5 - module for stacks of crates as ropes of shared chunks.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "rope.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define MIN_PIECES     (16U)
+#define COMPACT_PIECES (64U)  /* ropes of more pieces ... */
+#define COMPACT_LENGTH (16U)  /* ... of fewer crates on average are compacted */
+
+static chunk_t* new_chunk(size_t size);
+static void release(chunk_t* c);
+static void clear(rope_t* r);
+static int reserve(rope_t* r, size_t num);
+static void append(rope_t* r, piece_t p);
+static size_t split_top(rope_t* r, size_t num);
+static int compact(rope_t* r);
+
+void ropes_init(ropes_t* r)
+{
+    r->rope = NULL;
+    r->num = 0U;
+    r->capacity = 0U;
+}
+
+void ropes_free(ropes_t* r)
+{
+    for (size_t i = 0U; i < r->capacity; i++)
+    {
+        clear(&r->rope[i]);
+        free(r->rope[i].piece);
+    }
+    free(r->rope);
+    ropes_init(r);
+}
+
+int ropes_load(ropes_t* r, const stacks_t* s)
+{
+    for (size_t i = 0U; i < r->num; i++)
+        clear(&r->rope[i]);
+
+    if (s->num > r->capacity)
+    {
+        rope_t* rope = realloc(r->rope, s->num * sizeof(rope_t));
+        if (rope == NULL)
+            return 0;
+        for (size_t i = r->capacity; i < s->num; i++)
+        {
+            rope[i].piece = NULL;
+            rope[i].num = 0U;
+            rope[i].capacity = 0U;
+            rope[i].size = 0U;
+        }
+        r->rope = rope;
+        r->capacity = s->num;
+    }
+    r->num = s->num;
+
+    /* all stacks share one chunk */
+    size_t crates = 0U;
+    for (size_t i = 0U; i < s->num; i++)
+        crates += s->stack[i].size;
+    chunk_t* c = new_chunk(crates);
+    if (c == NULL)
+        return 0;
+
+    size_t start = 0U;
+    for (size_t i = 0U; i < s->num; i++)
+    {
+        size_t size = s->stack[i].size;
+        if (size == 0U)
+            continue;
+        if (!reserve(&r->rope[i], 1U))
+        {
+            release(c);
+            return 0;
+        }
+        memcpy(&c->data[start], s->stack[i].data, size);
+        piece_t p = { c, start, size, 0 };
+        c->refs++;
+        append(&r->rope[i], p);
+        start += size;
+    }
+    release(c);
+
+    return 1;
+}
+
+int ropes_move(ropes_t* r, size_t num, size_t from, size_t to, crane_t crane)
+{
+    if ((from >= r->num) || (to >= r->num) || (num > r->rope[from].size))
+        return 0;
+    if ((from == to) || (num == 0U))
+        return 1;
+
+    rope_t* src = &r->rope[from];
+    rope_t* dst = &r->rope[to];
+
+    /* the moved crates are the pieces from first on */
+    size_t first = split_top(src, num);
+    if (first == SIZE_MAX)
+        return 0;
+    size_t moved = src->num - first;
+    if (!reserve(dst, moved))
+        return 0;
+
+    if (crane == MOVE_AT_ONCE)
+    {
+        for (size_t i = first; i < src->num; i++)
+            append(dst, src->piece[i]);
+    }
+    else
+    {
+        for (size_t i = src->num; i > first; i--)
+        {
+            piece_t p = src->piece[i - 1U];
+            p.reversed = !p.reversed;
+            append(dst, p);
+        }
+    }
+    src->num = first;
+    src->size -= num;
+
+    return compact(dst);
+}
+
+void rope_copy(const rope_t* r, char* data)
+{
+    for (size_t i = 0U; i < r->num; i++)
+    {
+        const piece_t* p = &r->piece[i];
+        if (p->reversed)
+            crates_copy_reversed(data, &p->chunk->data[p->start], p->length);
+        else
+            memcpy(data, &p->chunk->data[p->start], p->length);
+        data += p->length;
+    }
+}
+
+char rope_top(const rope_t* r)
+{
+    if (r->num == 0U)
+        return '\0';
+
+    const piece_t* p = &r->piece[r->num - 1U];
+
+    return p->chunk->data[p->reversed ? p->start : (p->start + p->length - 1U)];
+}
+
+static chunk_t* new_chunk(size_t size)
+{
+    chunk_t* c = malloc(sizeof(chunk_t) + size);
+    if (c == NULL)
+        return NULL;
+    c->refs = 1U;
+    c->size = size;
+
+    return c;
+}
+
+static void release(chunk_t* c)
+{
+    if (--c->refs == 0U)
+        free(c);
+}
+
+static void clear(rope_t* r)
+{
+    for (size_t i = 0U; i < r->num; i++)
+        release(r->piece[i].chunk);
+    r->num = 0U;
+    r->size = 0U;
+}
+
+/* room for num more pieces */
+static int reserve(rope_t* r, size_t num)
+{
+    if ((r->num + num) <= r->capacity)
+        return 1;
+
+    size_t capacity = (r->capacity > 0U) ? r->capacity : MIN_PIECES;
+    while (capacity < (r->num + num))
+        capacity *= 2U;
+
+    piece_t* piece = realloc(r->piece, capacity * sizeof(piece_t));
+    if (piece == NULL)
+        return 0;
+    r->piece = piece;
+    r->capacity = capacity;
+
+    return 1;
+}
+
+/* put a piece on top, merged with the top piece if it continues it */
+static void append(rope_t* r, piece_t p)
+{
+    if (r->num > 0U)
+    {
+        piece_t* top = &r->piece[r->num - 1U];
+        if ((top->chunk == p.chunk) && (top->reversed == p.reversed))
+        {
+            if (!p.reversed && ((top->start + top->length) == p.start))
+            {
+                top->length += p.length;
+                r->size += p.length;
+                release(p.chunk);
+                return;
+            }
+            if (p.reversed && ((p.start + p.length) == top->start))
+            {
+                top->start = p.start;
+                top->length += p.length;
+                r->size += p.length;
+                release(p.chunk);
+                return;
+            }
+        }
+    }
+    r->piece[r->num++] = p;
+    r->size += p.length;
+}
+
+/*
+ * Split the piece holding the lowest of the top num crates, so they are whole
+ * pieces. Returns the index of the first of them or SIZE_MAX if there is not
+ * enough memory.
+ */
+static size_t split_top(rope_t* r, size_t num)
+{
+    size_t i = r->num;
+    size_t above = 0U;
+    while ((above + r->piece[i - 1U].length) < num)
+        above += r->piece[--i].length;
+    i--;
+
+    piece_t* p = &r->piece[i];
+    size_t upper = num - above;
+    if (upper == p->length)
+        return i;
+    if (!reserve(r, 1U))
+        return SIZE_MAX;
+    p = &r->piece[i];
+
+    /* the lower part stays, the upper part becomes a piece of its own */
+    size_t lower = p->length - upper;
+    piece_t top = *p;
+    top.length = upper;
+    if (p->reversed)
+        p->start += upper;
+    else
+        top.start += lower;
+    p->length = lower;
+    p->chunk->refs++;
+
+    memmove(&r->piece[i + 2U], &r->piece[i + 1U], (r->num - i - 1U) * sizeof(piece_t));
+    r->piece[i + 1U] = top;
+    r->num++;
+
+    return i + 1U;
+}
+
+/* copy all crates of a rope of many short pieces into a new chunk */
+static int compact(rope_t* r)
+{
+    if ((r->num <= COMPACT_PIECES) || ((r->num * COMPACT_LENGTH) <= r->size))
+        return 1;
+
+    chunk_t* c = new_chunk(r->size);
+    if (c == NULL)
+        return 0;
+
+    rope_copy(r, c->data);
+    size_t size = r->size;
+    clear(r);
+    piece_t p = { c, 0U, size, 0 };
+    append(r, p);
+
+    return 1;
+}
@@ -0,0 +1,73 @@
+/*
+ * Day 5 - module for stacks of crates as ropes of shared chunks.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef ROPE_H_
+#define ROPE_H_
+
+#include "crates.h"
+
+#include <stdlib.h>
+
+/* crates which never change, shared by all pieces referring to them */
+typedef struct
+{
+    size_t refs;
+    size_t size;
+    char data[];
+} chunk_t;
+
+/* crates data[start .. start + length - 1] of a chunk, bottom first unless reversed */
+typedef struct
+{
+    chunk_t* chunk;
+    size_t start;
+    size_t length;
+    int reversed;
+} piece_t;
+
+/* a stack as pieces, bottom first */
+typedef struct
+{
+    piece_t* piece;
+    size_t num;
+    size_t capacity;
+    size_t size;        /* crates */
+} rope_t;
+
+/* memory of the ropes only grows, so they can be reused for many inputs */
+typedef struct
+{
+    rope_t* rope;
+    size_t num;
+    size_t capacity;
+} ropes_t;
+
+/* no ropes, nothing is allocated */
+void ropes_init(ropes_t* r);
+
+void ropes_free(ropes_t* r);
+
+/* a rope of a single piece for each stack, returns 0 if there is not enough memory */
+int ropes_load(ropes_t* r, const stacks_t* s);
+
+/*
+ * Move num crates like stacks_move() by moving pieces. Only the lowest piece
+ * moved may be split, which shares its chunk. Moved one by one, the pieces
+ * are put on in reverse order and marked reversed. Ropes of many short pieces
+ * are copied into a new chunk.
+ */
+int ropes_move(ropes_t* r, size_t num, size_t from, size_t to, crane_t crane);
+
+/* copy the crates of a rope bottom first to data, which has room for all */
+void rope_copy(const rope_t* r, char* data);
+
+/* top most crate of a rope, 0 if empty */
+char rope_top(const rope_t* r);
+
+#endif /* ROPE_H_ */
@@ -0,0 +1,173 @@
+/*
+ * Solver for advent of code 2022 day 6.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day06.h"
+
+#include "markers.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_SIZE (65536U) /* datastreams of any length are fed block by block */
+
+typedef struct
+{
+    char* block;
+    detector_t detector;
+} state_t;
+
+static size_t marker_sizes[MARKERS_MAX] = { 4U, 14U };
+static size_t num_markers = 2U;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+static void report(state_t* s, unsigned long long stream, FILE* log, solver_result_t* result);
+static void append_marker(char answer[], unsigned long long start_of_packet);
+
+const solver_t day06_solver =
+{
+    .name = "day06",
+    .title = "Day 6: Tuning Trouble",
+    .part =
+    {
+        "first marker after character",
+        "first message after character"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+int day06_set_markers(const size_t* sizes, size_t num)
+{
+    detector_t d;
+    if (!detector_init(&d, sizes, num))
+        return 0;
+
+    memcpy(marker_sizes, sizes, num * sizeof(size_t));
+    num_markers = num;
+
+    return 1;
+}
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->block = malloc(BLOCK_SIZE);
+    if (s->block == NULL)
+    {
+        free(s);
+        return NULL;
+    }
+    (void) detector_init(&s->detector, marker_sizes, num_markers);
+
+    return s;
+}
+
+/*
+ * Each line is a datastream. The part of it in a block is fed to the detector
+ * up to the line end, so a carriage return before it is not part of it. One at
+ * the end of a block is kept for the next one to tell.
+ */
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    detector_t* d = &s->detector;
+    unsigned long long stream = 0U;
+
+    detector_reset(d);
+
+    size_t used = 0U;
+    size_t n;
+    while ((n = fread(&s->block[used], 1U, BLOCK_SIZE - used, fp)) > 0U)
+    {
+        used += n;
+
+        size_t i = 0U;
+        while (i < used)
+        {
+            const char* eol = memchr(&s->block[i], '\n', used - i);
+            size_t end = (eol != NULL) ? (size_t)(eol - s->block) : used;
+            size_t len = end - i;
+            if ((len > 0U) && (s->block[end - 1U] == '\r'))
+                len--;
+
+            detector_feed(d, &s->block[i], len);
+            i += len;
+            if (eol == NULL)
+                break;
+
+            if (d->pos > 0U) /* empty lines are skipped */
+                report(s, ++stream, log, result);
+            i = end + 1U;
+        }
+        used -= i;
+        memmove(s->block, &s->block[i], used);
+    }
+    if (ferror(fp))
+    {
+        fprintf(stderr, "Could not read input!");
+        return 0;
+    }
+
+    detector_feed(d, s->block, used); /* a carriage return without line end */
+    if (d->pos > 0U)
+        report(s, ++stream, log, result);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    free(s->block);
+    free(s);
+}
+
+/* markers of a datastream, the detector starts over for the next one */
+static void report(state_t* s, unsigned long long stream, FILE* log, solver_result_t* result)
+{
+    detector_t* d = &s->detector;
+
+    solver_log(log, "datastream %llu:\n", stream);
+    for (size_t i = 0U; i < d->num; i++)
+    {
+        if (d->end[i] > 0U)
+            solver_log(log, "> marker of %llu after character %llu\n", (unsigned long long) d->size[i], d->end[i]);
+        else
+            solver_log(log, "> no marker of %llu found!\n", (unsigned long long) d->size[i]);
+        if (i < SOLVER_NUM_PARTS)
+            append_marker(result->answer[i], d->end[i]);
+    }
+    solver_log(log, "\n");
+
+    detector_reset(d);
+}
+
+/* answers are comma separated lists, one entry per datastream */
+static void append_marker(char answer[], unsigned long long start_of_packet)
+{
+    size_t len = strlen(answer);
+
+    if (len >= (SOLVER_ANSWER_SIZE - 1U))
+        return;
+
+    if (start_of_packet)
+        (void) snprintf(&answer[len], SOLVER_ANSWER_SIZE - len, "%s%llu",
+                        (len > 0U) ? "," : "", start_of_packet);
+    else
+        (void) snprintf(&answer[len], SOLVER_ANSWER_SIZE - len, "%snone",
+                        (len > 0U) ? "," : "");
+}
@@ -0,0 +1,34 @@
+/*
+ * Solver for advent of code 2022 day 6.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY06_H_
+#define DAY06_H_
+
+#include "solver.h"
+
+#include <stdlib.h>
+
+extern const solver_t day06_solver;
+
+/**
+ * \brief Set the sizes of the markers searched in each datastream.
+ *
+ * The first two are the answers of part 1 and 2, all are logged. Applies to
+ * states created afterwards, so it must be set before solving.
+ *
+ * \param[in] sizes Marker sizes, 1 to MARKER_MAX_SIZE each.
+ * \param[in] num   Number of sizes, 1 to MARKERS_MAX.
+ *
+ * \return int
+ * \retval 0 Invalid sizes.
+ * \retval 1 Success.
+ */
+int day06_set_markers(const size_t* sizes, size_t num);
+
+#endif /* DAY06_H_ */
@@ -7,90 +7,288 @@
  * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
  */
 
-#include <assert.h>
+/*
+ * Besides the options of all days, this program accepts:
+ *
+ *   -k                   benchmark of finding markers of 4 up to 26
+ *                        characters, or the sizes of -m, in the first
+ *                        datastream of each file by the lookup table of each
+ *                        window vs. the sliding window vs. the letter masks
+ *   -m sizes             comma separated sizes of the markers searched in
+ *                        each datastream, the first two are the answers
+ *   -g MB letters file   generate a datastream of the given size in megabytes
+ *                        of random letters out of the first ones of the
+ *                        alphabet, ending with all 26 letters
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "day06.h"
+#include "markers.h"
+
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#define BENCH_REPETITIONS (5U)
+#define GEN_BUFFER_SIZE   (65536U)
+#define ALPHABET          (26U)
+
+/* ways to find a marker, compared by -k */
+#define KERNEL_LUT     (0U)
+#define KERNEL_WINDOW  (1U)
+#define KERNEL_LETTERS (2U)
+#define KERNELS        (3U)
 
-#define MAX_LINE_SIZE (4097U) /* max line length of input file, incl. EOL */
+typedef size_t (*find_t)(const char* data, size_t len, size_t size);
 
-static size_t find_start_of_packet(const char datastream[], size_t len, size_t marker);
-static int unique(const char s[], size_t len);
+static const size_t bench_sizes[] = { 4U, 8U, 14U, 20U, 26U };
+
+static int parse_sizes(const char* list, size_t* sizes, size_t* num);
+static int run_kernels(int files, char* names[], const size_t* sizes, size_t num);
+static int lowercase(const char* data, size_t len);
+static double time_kernel(find_t find, const char* data, size_t len, size_t size, size_t* end);
+static int read_file(const char* name, char** data, size_t* size);
+static int generate(const char* name, unsigned long mb, unsigned long letters);
+static size_t random_below(size_t n);
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1);
 
 int main(int argc, char *argv[])
 {
-    printf("Advent of Code 2022 - Day 6: Tuning Trouble\n\n");
+    int kernels = 0;
+    size_t sizes[MARKERS_MAX];
+    size_t num = 0U;
 
-    if (argc != 2)
+    /* day specific options are handled here, other arguments are passed on */
+    int args = 1;
+    for (int i = 1; i < argc; i++)
     {
-        fprintf(stderr, "Please provide data record file name.");
-        exit(EXIT_FAILURE);
+        if (strcmp(argv[i], "-k") == 0)
+        {
+            kernels = 1;
+        }
+        else if (strcmp(argv[i], "-m") == 0)
+        {
+            if (   ((i + 1) >= argc)
+                || !parse_sizes(argv[++i], sizes, &num)
+                || !day06_set_markers(sizes, num))
+            {
+                fprintf(stderr, "Invalid marker sizes, up to %u of 1 to %u!\n", MARKERS_MAX, MARKER_MAX_SIZE);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strcmp(argv[i], "-g") == 0)
+        {
+            unsigned long mb, letters;
+            if (   ((i + 3) >= argc)
+                || (sscanf(argv[i + 1], "%lu", &mb) != 1)
+                || (sscanf(argv[i + 2], "%lu", &letters) != 1)
+                || (mb == 0U)
+                || (letters == 0U)
+                || (letters > ALPHABET))
+            {
+                fprintf(stderr, "Invalid size, number of letters (1 to 26) or file name!\n");
+                return EXIT_FAILURE;
+            }
+            return generate(argv[i + 3], mb, letters);
+        }
+        else
+        {
+            argv[args++] = argv[i];
+        }
     }
+    argv[args] = NULL;
 
-    FILE* fp = fopen(argv[1], "r");
+    if (kernels && (num == 0U))
+        return run_kernels(args - 1, &argv[1], bench_sizes, sizeof(bench_sizes) / sizeof(bench_sizes[0]));
+    if (kernels)
+        return run_kernels(args - 1, &argv[1], sizes, num);
+
+    return solver_main(&day06_solver, args, argv);
+}
 
-    if (!fp)
+/* "4,14,20" */
+static int parse_sizes(const char* list, size_t* sizes, size_t* num)
+{
+    size_t n = 0U;
+    for (;;)
     {
-        fprintf(stderr, "Could not open file!");
-        exit(EXIT_FAILURE);
+        if ((*list < '0') || (*list > '9') || (n >= MARKERS_MAX))
+            return 0;
+
+        char* end;
+        unsigned long size = strtoul(list, &end, 10);
+        if (size > MARKER_MAX_SIZE)
+            return 0;
+        sizes[n++] = (size_t) size;
+        if (*end == '\0')
+            break;
+        if (*end != ',')
+            return 0;
+        list = end + 1;
     }
+    *num = n;
+
+    return 1;
+}
 
-    char line_buf[MAX_LINE_SIZE];
-    while (fgets(line_buf, MAX_LINE_SIZE, fp))
+static int run_kernels(int files, char* names[], const size_t* sizes, size_t num)
+{
+    static const find_t finds[KERNELS] = { marker_find_lut, marker_find, marker_find_letters };
+#if defined(__AVX2__)
+    static const char* const kernels[KERNELS] = { "lut", "window", "letters+avx2" };
+#else
+    static const char* const kernels[KERNELS] = { "lut", "window", "letters" };
+#endif
+
+    for (int i = 0; i < files; i++)
     {
-        size_t len = strlen(line_buf);
-        size_t start_of_packet;
+        char* data;
+        size_t len;
+        if (!read_file(names[i], &data, &len))
+        {
+            fprintf(stderr, "Could not read file %s!\n", names[i]);
+            return EXIT_FAILURE;
+        }
+        const char* eol = memchr(data, '\n', len);
+        if (eol != NULL)
+            len = (size_t)(eol - data);
+        if ((len > 0U) && (data[len - 1U] == '\r'))
+            len--;
+        unsigned int used = lowercase(data, len) ? KERNELS : KERNEL_LETTERS;
 
-        assert(len > 0U);
-        len--; /* ignore EOL */
+        printf("%s: %llu characters%s\n", names[i], (unsigned long long) len,
+               (used < KERNELS) ? ", not only lowercase letters" : "");
+        for (size_t k = 0U; k < num; k++)
+        {
+            size_t end[KERNELS];
+            double t[KERNELS];
+            for (unsigned int kernel = 0U; kernel < used; kernel++)
+            {
+                t[kernel] = time_kernel(finds[kernel], data, len, sizes[k], &end[kernel]);
+                if (end[kernel] != end[KERNEL_LUT])
+                {
+                    fprintf(stderr, "Kernels disagree on file %s!\n", names[i]);
+                    free(data);
+                    return EXIT_FAILURE;
+                }
+            }
 
-        printf("part 1:\n");
-        start_of_packet = find_start_of_packet(line_buf, len, 4U);
-        if (start_of_packet)
-            printf("> first marker after character = %lld\n", start_of_packet);
-        else
-            printf("> no marker found!\n");
+            /* all characters are scanned if there is no marker */
+            double scanned = (double)((end[KERNEL_LUT] > 0U) ? end[KERNEL_LUT] : len);
+            printf("marker of %3llu after %12llu:", (unsigned long long) sizes[k],
+                   (unsigned long long) end[KERNEL_LUT]);
+            for (unsigned int kernel = 0U; kernel < used; kernel++)
+                printf(" %s %7.3f GB/s", kernels[kernel], (scanned / t[kernel]) / 1e9);
+            printf("\n");
+        }
+        free(data);
+    }
 
-        printf("part 2:\n");
-        start_of_packet = find_start_of_packet(line_buf, len, 14U);
-        if (start_of_packet)
-            printf("> first marker after character = %lld\n", start_of_packet);
-        else
-            printf("> no marker found!\n");
-        printf("\n");
+    return EXIT_SUCCESS;
+}
+
+static int lowercase(const char* data, size_t len)
+{
+    for (size_t i = 0U; i < len; i++)
+    {
+        if ((data[i] < 'a') || (data[i] > 'z'))
+            return 0;
     }
 
-    fclose(fp);
+    return 1;
+}
 
-    return EXIT_SUCCESS;
+/* fastest of some runs, which is least disturbed by other processes */
+static double time_kernel(find_t find, const char* data, size_t len, size_t size, size_t* end)
+{
+    double best = 0.0;
+    for (unsigned int rep = 0U; rep < BENCH_REPETITIONS; rep++)
+    {
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        *end = find(data, len, size);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double t = elapsed_s(&t0, &t1);
+        if ((rep == 0U) || (t < best))
+            best = t;
+    }
+
+    return best;
 }
 
-static size_t find_start_of_packet(const char datastream[], size_t len, size_t marker)
+static int read_file(const char* name, char** data, size_t* size)
 {
-    assert(marker > 0);
-    assert(len > marker);
+    FILE* fp = fopen(name, "rb");
+    if (fp == NULL)
+        return 0;
 
-    for (size_t i = marker - 1U; i < len; i++)
-        if (unique(&datastream[i - marker + 1U], marker))
-            return i + 1U;
+    int ok = 0;
+    long len;
+    if (   (fseek(fp, 0L, SEEK_END) == 0)
+        && ((len = ftell(fp)) >= 0L)
+        && (fseek(fp, 0L, SEEK_SET) == 0))
+    {
+        *size = (size_t) len;
+        *data = malloc((*size > 0U) ? *size : 1U);
+        ok = (*data != NULL) && (fread(*data, 1U, *size, fp) == *size);
+        if (!ok)
+            free(*data);
+    }
+    fclose(fp);
 
-    return 0U;
+    return ok;
 }
 
-int unique(const char s[], size_t len)
+/*
+ * A single line, reproducible by a fixed seed. Markers of more characters than
+ * letters are only found in the whole alphabet at the end.
+ */
+static int generate(const char* name, unsigned long mb, unsigned long letters)
 {
-    int lut[128] = {0};
+    FILE* fp = fopen(name, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return EXIT_FAILURE;
+    }
 
-    for (size_t i = 0U; i < len; i++)
+    static char buf[GEN_BUFFER_SIZE];
+    unsigned long long total = (unsigned long long) mb * 1000000U;
+    unsigned long long written = 0U;
+    int ok = 1;
+    while (ok && (written < total))
     {
-        int n = (int) s[i];
-        assert(n >= 0);
-        assert(n < 128);
-        if (lut[n] != 0)
-            return 0;
-        else
-            lut[n] = 1;
+        size_t n = ((total - written) < GEN_BUFFER_SIZE) ? (size_t)(total - written) : GEN_BUFFER_SIZE;
+        for (size_t i = 0U; i < n; i++)
+            buf[i] = (char)('a' + (int) random_below(letters));
+        ok = (fwrite(buf, 1U, n, fp) == n);
+        written += n;
+    }
+    ok = ok && (fputs("abcdefghijklmnopqrstuvwxyz\n", fp) != EOF);
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "Could not write file %s!\n", name);
+        return EXIT_FAILURE;
     }
 
-    return 1;
-}
\ No newline at end of file
+    return EXIT_SUCCESS;
+}
+
+/* xorshift64, https://en.wikipedia.org/wiki/Xorshift */
+static size_t random_below(size_t n)
+{
+    static unsigned long long rng = 88172645463325252U;
+
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+
+    return (size_t)((rng >> 8) % n);
+}
+
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1)
+{
+    return (double)(t1->tv_sec - t0->tv_sec) + ((double)(t1->tv_nsec - t0->tv_nsec) / 1e9);
+}
@@ -0,0 +1,230 @@
+/*
+ * Day 6 - module to find markers of distinct characters in datastreams.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "markers.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define VECTOR_SIZE (32U) /* characters */
+
+static uint32_t pairs_mask(const char* data);
+static unsigned int lowest_bit(uint32_t mask);
+static size_t scan_letters(const char* data, size_t from, size_t to, size_t size);
+static unsigned int popcount(uint32_t mask);
+static int unique(const char s[], size_t len);
+
+size_t marker_find(const char* data, size_t len, size_t size)
+{
+    /* position after the last occurrence of each character, 0 if none */
+    size_t after[256];
+    memset(after, 0, sizeof(after));
+
+    size_t start = 0U;
+    for (size_t i = 0U; i < len; i++)
+    {
+        unsigned char c = (unsigned char) data[i];
+        if (after[c] > start)
+            start = after[c];
+        after[c] = i + 1U;
+        if ((i + 1U - start) == size)
+            return i + 1U;
+    }
+
+    return 0U;
+}
+
+size_t marker_find_letters(const char* data, size_t len, size_t size)
+{
+    if ((size == 0U) || (size > 26U) || (len < size))
+        return 0U;
+
+    /* runs without equal neighbours are checked for windows of distinct letters */
+    size_t run = 0U;
+    size_t i = 0U;
+    size_t end;
+    while ((i + VECTOR_SIZE) < len)
+    {
+        for (uint32_t pairs = pairs_mask(&data[i]); pairs != 0U; pairs &= pairs - 1U)
+        {
+            size_t last = i + (size_t) lowest_bit(pairs);
+            if (((last + 1U - run) >= size) && ((end = scan_letters(data, run, last + 1U, size)) > 0U))
+                return end;
+            run = last + 1U;
+        }
+        i += VECTOR_SIZE;
+    }
+    for (; (i + 1U) < len; i++)
+    {
+        if (data[i] != data[i + 1U])
+            continue;
+        if (((i + 1U - run) >= size) && ((end = scan_letters(data, run, i + 1U, size)) > 0U))
+            return end;
+        run = i + 1U;
+    }
+
+    return ((len - run) >= size) ? scan_letters(data, run, len, size) : 0U;
+}
+
+int detector_init(detector_t* d, const size_t* sizes, size_t num)
+{
+    if ((num == 0U) || (num > MARKERS_MAX))
+        return 0;
+
+    for (size_t i = 0U; i < num; i++)
+    {
+        if ((sizes[i] == 0U) || (sizes[i] > MARKER_MAX_SIZE))
+            return 0;
+        d->size[i] = sizes[i];
+
+        /* insertion sort of the few sizes */
+        size_t j = i;
+        for (; (j > 0U) && (d->size[d->order[j - 1U]] > sizes[i]); j--)
+            d->order[j] = d->order[j - 1U];
+        d->order[j] = i;
+    }
+    d->num = num;
+    detector_reset(d);
+
+    return 1;
+}
+
+void detector_reset(detector_t* d)
+{
+    memset(d->after, 0, sizeof(d->after));
+    d->start = 0U;
+    d->pos = 0U;
+    for (size_t i = 0U; i < d->num; i++)
+        d->end[i] = 0U;
+    d->found = 0U;
+}
+
+void detector_feed(detector_t* d, const char* data, size_t len)
+{
+    if (detector_done(d))
+        return;
+
+    unsigned long long* after = d->after;
+    unsigned long long start = d->start;
+    unsigned long long pos = d->pos;
+    unsigned long long next = d->size[d->order[d->found]];
+    for (size_t i = 0U; i < len; i++)
+    {
+        unsigned char c = (unsigned char) data[i];
+        if (after[c] > start)
+            start = after[c];
+        after[c] = ++pos;
+        if ((pos - start) < next)
+            continue;
+
+        /* the window grows by one at most, so it ends right at the marker */
+        while ((d->found < d->num) && ((pos - start) >= d->size[d->order[d->found]]))
+            d->end[d->order[d->found++]] = pos;
+        if (detector_done(d))
+            break;
+        next = d->size[d->order[d->found]];
+    }
+    d->start = start;
+    d->pos = pos;
+}
+
+int detector_done(const detector_t* d)
+{
+    return (d->found == d->num);
+}
+
+size_t marker_find_lut(const char* data, size_t len, size_t size)
+{
+    for (size_t i = size; i <= len; i++)
+    {
+        if (unique(&data[i - size], size))
+            return i;
+    }
+
+    return 0U;
+}
+
+/* bit j is set if data[j] equals data[j + 1], for 32 characters */
+static uint32_t pairs_mask(const char* data)
+{
+#if defined(__AVX2__)
+    __m256i a = _mm256_loadu_si256((const __m256i*) data);
+    __m256i b = _mm256_loadu_si256((const __m256i*) &data[1]);
+
+    return (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+#else
+    uint32_t pairs = 0U;
+    for (unsigned int j = 0U; j < VECTOR_SIZE; j++)
+        pairs |= (uint32_t)(data[j] == data[j + 1U]) << j;
+
+    return pairs;
+#endif
+}
+
+static unsigned int lowest_bit(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return (unsigned int) __builtin_ctz(mask);
+#else
+    unsigned int n = 0U;
+    for (; (mask & 1U) == 0U; mask >>= 1)
+        n++;
+    return n;
+#endif
+}
+
+/* end of the first window of distinct letters within data[from .. to - 1], or 0 */
+static size_t scan_letters(const char* data, size_t from, size_t to, size_t size)
+{
+    uint32_t mask = 0U;
+    for (size_t i = from; i < (from + size - 1U); i++)
+        mask ^= (uint32_t) 1U << (data[i] & 31);
+
+    for (size_t i = from + size - 1U; i < to; i++)
+    {
+        mask ^= (uint32_t) 1U << (data[i] & 31);
+        if (popcount(mask) == size)
+            return i + 1U;
+        mask ^= (uint32_t) 1U << (data[i + 1U - size] & 31);
+    }
+
+    return 0U;
+}
+
+static unsigned int popcount(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return (unsigned int) __builtin_popcount(mask);
+#else
+    unsigned int n = 0U;
+    for (; mask != 0U; mask &= mask - 1U)
+        n++;
+    return n;
+#endif
+}
+
+static int unique(const char s[], size_t len)
+{
+    int lut[256] = {0};
+
+    for (size_t i = 0U; i < len; i++)
+    {
+        unsigned char n = (unsigned char) s[i];
+        if (lut[n] != 0)
+            return 0;
+        else
+            lut[n] = 1;
+    }
+
+    return 1;
+}
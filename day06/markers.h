@@ -0,0 +1,69 @@
+/*
+ * Day 6 - module to find markers of distinct characters in datastreams.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef MARKERS_H_
+#define MARKERS_H_
+
+#include <stdlib.h>
+
+#define MARKER_MAX_SIZE (256U) /* there are no more distinct characters */
+#define MARKERS_MAX     (16U)  /* sizes searched at once */
+
+/* markers of several sizes in a datastream fed in pieces of any length */
+typedef struct
+{
+    unsigned long long after[256];        /* position after the last occurrence of each character */
+    unsigned long long start;             /* of the window of distinct characters */
+    unsigned long long pos;               /* characters so far */
+    size_t size[MARKERS_MAX];
+    unsigned long long end[MARKERS_MAX];  /* as marker_find(), 0 if not found (yet) */
+    size_t order[MARKERS_MAX];            /* of the sizes ascending */
+    size_t num;
+    size_t found;                         /* markers of the smallest sizes */
+} detector_t;
+
+/*
+ * Number of characters up to the end of the first marker of size distinct
+ * characters, 0 if there is none. The window slides past the previous
+ * occurrence of each repeated character, which costs the same for any size.
+ */
+size_t marker_find(const char* data, size_t len, size_t size);
+
+/*
+ * Same as marker_find() for datastreams of lowercase letters only, others give
+ * wrong results. Windows with two equal neighbours are skipped, they are found
+ * 32 characters at once, by AVX2 if enabled. The others are checked by a mask
+ * of the letters occurring an odd number of times: it has as many bits set as
+ * the window is long if all are distinct.
+ */
+size_t marker_find_letters(const char* data, size_t len, size_t size);
+
+/* same as marker_find() by checking each window with a lookup table, as reference */
+size_t marker_find_lut(const char* data, size_t len, size_t size);
+
+/*
+ * Search markers of the given sizes, 1 to MARKER_MAX_SIZE each. Returns 0 for
+ * more than MARKERS_MAX, none or invalid sizes.
+ */
+int detector_init(detector_t* d, const size_t* sizes, size_t num);
+
+/* start a new datastream, no markers are found */
+void detector_reset(detector_t* d);
+
+/*
+ * Continue the datastream. Its window of distinct characters ends at each
+ * character, a marker is found as soon as it is as long as its size. This
+ * happens for the sizes in ascending order, so all are found in a single pass.
+ */
+void detector_feed(detector_t* d, const char* data, size_t len);
+
+/* all markers have been found, the rest of the datastream can be skipped */
+int detector_done(const detector_t* d);
+
+#endif /* MARKERS_H_ */
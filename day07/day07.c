@@ -0,0 +1,109 @@
+/*
+ * Solver for advent of code 2022 day 7.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day07.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_SIZE       (65536U) /* longest line */
+#define DIR_MAX_SIZE     (100000U) /* limit for part 1*/
+#define TOTAL_DISK_SPACE (70000000U)
+#define MIN_FREE_SPACE   (30000000U)
+
+typedef struct
+{
+    char* block;
+    tree_t tree;
+} state_t;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+
+const solver_t day07_solver =
+{
+    .name = "day07",
+    .title = "Day 7: No Space Left On Device",
+    .part =
+    {
+        "total size of all directories not larger than 100000",
+        "smallest directory to delete to get enough free space"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+void day07_answer(const tree_t* t, solver_result_t* result)
+{
+    /* nothing has to be deleted if there is enough free space */
+    unsigned long long used_space = t->node[TREE_ROOT].size;
+    unsigned long long max_used = TOTAL_DISK_SPACE - MIN_FREE_SPACE;
+    unsigned long long needed = (used_space > max_used) ? (used_space - max_used) : 0U;
+
+    /* part 1 and 2 in a single pass, root is large enough for part 2 */
+    unsigned long long part1 = 0U;
+    unsigned long long part2 = used_space;
+    for (size_t i = 0U; i < t->num; i++)
+    {
+        unsigned long long size = t->node[i].size;
+        if (size <= DIR_MAX_SIZE)
+            part1 += size;
+        if ((size >= needed) && (size < part2))
+            part2 = size;
+    }
+    solver_answer(result, 1U, "%llu", part1);
+    solver_answer(result, 2U, "%llu", (needed > 0U) ? part2 : 0U);
+}
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->block = malloc(BLOCK_SIZE);
+    if ((s->block == NULL) || !tree_init(&s->tree))
+    {
+        free(s->block);
+        free(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    tree_t* t = &s->tree;
+
+    tree_clear(t);
+
+    if (!tree_read(t, fp, s->block, BLOCK_SIZE))
+        return 0;
+    tree_sizes(t);
+    solver_log(log, "%llu directories, %llu in total\n\n",
+               (unsigned long long) t->num, t->node[TREE_ROOT].size);
+
+    day07_answer(t, result);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    free(s->block);
+    tree_free(&s->tree);
+    free(s);
+}
@@ -0,0 +1,26 @@
+/*
+ * Solver for advent of code 2022 day 7.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY07_H_
+#define DAY07_H_
+
+#include "solver.h"
+#include "tree.h"
+
+extern const solver_t day07_solver;
+
+/**
+ * \brief Store both answers from the sizes of all directories.
+ *
+ * \param[in]  t      Tree after tree_sizes() or a live one.
+ * \param[out] result Answers.
+ */
+void day07_answer(const tree_t* t, solver_result_t* result);
+
+#endif /* DAY07_H_ */
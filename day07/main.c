@@ -7,108 +7,376 @@
  * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
  */
 
-#include "compare.h"
+/*
+ * Besides the options of all days, this program accepts:
+ *
+ *   -g dirs depth file  generate a terminal log of the given number of
+ *                       directories, which are nested as deep as given
+ *   -q file queries     index the directories of a log by size and answer
+ *                       queries "X" from a file or standard input "-" by the
+ *                       smallest directory of at least size X
+ *   -i index log        continue the tree saved in the index file with the
+ *                       lines appended to the log since, save it and answer
+ *                       both parts; the index is created if it is missing
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "day07.h"
+#include "sizes.h"
+#include "tree.h"
 
-#include <assert.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-#define MAX_LINE_SIZE (128) /* max line length of input file, incl. EOL */
-#define MAX_NUM_DIRS  (500)
-#define DIR_MAX_SIZE     (100000) /* limit for part 1*/
-#define TOTAL_DISK_SPACE (70000000)
-#define MIN_FREE_SPACE   (30000000)
-
-static int dir_sizes[MAX_NUM_DIRS] = {0};
-static int depth = 0;
+#define LOG_BLOCK_SIZE  (65536U)
+#define GEN_BUFFER_SIZE (65536U)
+#define GEN_FILE_SIZE   (200000U) /* file sizes are below */
 
-static int scan_dirs_recursively(FILE *fp);
+static int run_incremental(const char* index, const char* log);
+static int save_index(const char* index, const tree_t* t, unsigned long long offset);
+static int run_queries(const char* log, const char* queries);
+static int index_log(const char* log, tree_t* t, sizes_t* s);
+static int generate(const char* name, unsigned long long dirs, unsigned long long depth);
+static size_t random_below(size_t n);
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1);
 
 int main(int argc, char *argv[])
 {
-    printf("Advent of Code 2022 - Day 7: No Space Left On Device\n\n");
-
-    if (argc != 2)
+    /* day specific options are handled here, other arguments are passed on */
+    int args = 1;
+    for (int i = 1; i < argc; i++)
     {
-        fprintf(stderr, "Please provide data record file name.");
-        exit(EXIT_FAILURE);
+        if (strcmp(argv[i], "-g") == 0)
+        {
+            unsigned long long dirs, depth;
+            if (   ((i + 3) >= argc)
+                || (sscanf(argv[i + 1], "%llu", &dirs) != 1)
+                || (sscanf(argv[i + 2], "%llu", &depth) != 1)
+                || (depth == 0U)
+                || (depth >= dirs))
+            {
+                fprintf(stderr, "Invalid number of directories, depth (less) or file name!\n");
+                return EXIT_FAILURE;
+            }
+            return generate(argv[i + 3], dirs, depth);
+        }
+        else if (strcmp(argv[i], "-q") == 0)
+        {
+            if ((i + 2) >= argc)
+            {
+                fprintf(stderr, "Missing file of log or queries!\n");
+                return EXIT_FAILURE;
+            }
+            return run_queries(argv[i + 1], argv[i + 2]);
+        }
+        else if (strcmp(argv[i], "-i") == 0)
+        {
+            if ((i + 2) >= argc)
+            {
+                fprintf(stderr, "Missing index or log file!\n");
+                return EXIT_FAILURE;
+            }
+            return run_incremental(argv[i + 1], argv[i + 2]);
+        }
+        else
+        {
+            argv[args++] = argv[i];
+        }
     }
+    argv[args] = NULL;
 
-    FILE* fp = fopen(argv[1], "r");
+    return solver_main(&day07_solver, args, argv);
+}
 
-    if (!fp)
+/*
+ * The saved tree is live, so new files only update the sizes of their
+ * ancestors. A log shorter than the part already parsed has been replaced,
+ * it is parsed from the start then.
+ */
+static int run_incremental(const char* index, const char* log)
+{
+    tree_t t;
+    if (!tree_init(&t))
     {
-        fprintf(stderr, "Could not open file!");
-        exit(EXIT_FAILURE);
+        fprintf(stderr, "Not enough memory!\n");
+        return EXIT_FAILURE;
     }
 
-    int dir_size_total = scan_dirs_recursively(fp);
+    unsigned long long offset = 0U;
+    FILE* ip = fopen(index, "rb");
+    if (ip != NULL)
+    {
+        if (!tree_load(&t, ip, &offset))
+        {
+            printf("index %s is invalid, it is created again\n", index);
+            offset = 0U;
+        }
+        fclose(ip);
+    }
+    if (offset == 0U)
+        tree_live(&t);
+
+    FILE* fp = fopen(log, "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", log);
+        tree_free(&t);
+        return EXIT_FAILURE;
+    }
+    long len;
+    if ((fseek(fp, 0L, SEEK_END) != 0) || ((len = ftell(fp)) < 0L))
+    {
+        fprintf(stderr, "Could not read file %s!\n", log);
+        fclose(fp);
+        tree_free(&t);
+        return EXIT_FAILURE;
+    }
+    if ((unsigned long long) len < offset)
+    {
+        printf("log %s is shorter than indexed, it is parsed from the start\n", log);
+        tree_clear(&t);
+        tree_live(&t);
+        offset = 0U;
+    }
 
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    unsigned long long start = offset;
+    unsigned long long line = t.line;
+    char* block = malloc(LOG_BLOCK_SIZE);
+    int ok =    (block != NULL)
+             && (fseek(fp, (long) offset, SEEK_SET) == 0)
+             && tree_follow(&t, fp, block, LOG_BLOCK_SIZE, &offset);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    free(block);
     fclose(fp);
+    if (!ok)
+    {
+        fprintf(stderr, "\nCould not parse file %s!\n", log);
+        tree_free(&t);
+        return EXIT_FAILURE;
+    }
+    printf("%llu new lines (%llu bytes) in %.3f s, %llu directories\n", t.line - line, offset - start,
+           elapsed_s(&t0, &t1), (unsigned long long) t.num);
 
-    /* part 1 */
-    int part1 = 0;
-    for (int i = 0; i < MAX_NUM_DIRS; i++)
+    ok = save_index(index, &t, offset);
+    if (ok)
     {
-        if (dir_sizes[i] <= DIR_MAX_SIZE)
-        {
-            part1 += dir_sizes[i];
-        }
+        solver_result_t result;
+        day07_answer(&t, &result);
+        for (size_t p = 0U; p < SOLVER_NUM_PARTS; p++)
+            printf("Part %u: %s = %s\n", (unsigned) p + 1U, day07_solver.part[p], result.answer[p]);
+    }
+    tree_free(&t);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* written to another file first, so the index is never left half written */
+static int save_index(const char* index, const tree_t* t, unsigned long long offset)
+{
+    size_t len = strlen(index);
+    char* temp = malloc(len + sizeof(".tmp"));
+    if (temp == NULL)
+    {
+        fprintf(stderr, "Not enough memory!\n");
+        return 0;
     }
-    printf("part 1: total size of all directories not larger than 100000 = %d\n", part1);
+    memcpy(temp, index, len);
+    memcpy(&temp[len], ".tmp", sizeof(".tmp"));
 
-    /* part 2*/
-    int free_space = TOTAL_DISK_SPACE - dir_size_total;
-    qsort(dir_sizes, MAX_NUM_DIRS, sizeof(int), compare_ints);
-    for (int i = 0; i < MAX_NUM_DIRS; i++)
+    FILE* fp = fopen(temp, "wb");
+    int ok = (fp != NULL) && tree_save(t, fp, offset);
+    ok = (fp != NULL) && (fclose(fp) == 0) && ok;
+    ok = ok && (rename(temp, index) == 0);
+    if (!ok)
     {
-        if (free_space + dir_sizes[i] >= MIN_FREE_SPACE)
+        fprintf(stderr, "Could not write file %s!\n", index);
+        (void) remove(temp);
+    }
+    free(temp);
+
+    return ok;
+}
+
+static int run_queries(const char* log, const char* queries)
+{
+    tree_t t;
+    sizes_t s;
+    if (!tree_init(&t))
+    {
+        fprintf(stderr, "Not enough memory!\n");
+        return EXIT_FAILURE;
+    }
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int ok = index_log(log, &t, &s);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (!ok)
+    {
+        tree_free(&t);
+        return EXIT_FAILURE;
+    }
+    printf("%llu directories indexed in %.3f s\n", (unsigned long long) s.num, elapsed_s(&t0, &t1));
+
+    int interactive = (strcmp(queries, "-") == 0);
+    FILE* fp = interactive ? stdin : fopen(queries, "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", queries);
+        sizes_free(&s);
+        tree_free(&t);
+        return EXIT_FAILURE;
+    }
+
+    char* line = NULL; /* queries may be of any length */
+    size_t length = 0U;
+    ssize_t len;
+    unsigned long long count = 0U;
+    double total = 0.0;
+    while ((len = getline(&line, &length, fp)) != -1)
+    {
+        unsigned long long size;
+        char rest;
+        count++;
+        /* a null character would hide the rest of the line from sscanf() */
+        if ((strlen(line) != (size_t) len) || (sscanf(line, "%llu %c", &size, &rest) != 1))
         {
-            printf("part 2: smallest directory to delete to get enough free space = %d\n", dir_sizes[i]);
+            fprintf(stderr, "Unexpected data in query %llu!\n", count);
+            ok = 0;
             break;
         }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        const entry_t* e = sizes_smallest(&s, size);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        total += elapsed_s(&t0, &t1);
+
+        if (e == NULL)
+        {
+            printf("%llu: none\n", size);
+        }
+        else
+        {
+            const node_t* node = &t.node[e->id];
+            printf("%llu: %llu %.*s\n", size, e->size, (e->id == TREE_ROOT) ? 1 : (int) node->name_length,
+                   (e->id == TREE_ROOT) ? "/" : &t.names[node->name]);
+        }
     }
+    free(line);
+    if (!interactive)
+        fclose(fp);
+    sizes_free(&s);
+    tree_free(&t);
+    if (!ok)
+        return EXIT_FAILURE;
+
+    if (count > 0U)
+        printf("%llu queries in %.3f us each\n", count, (total / (double) count) * 1e6);
 
     return EXIT_SUCCESS;
 }
 
-static int scan_dirs_recursively(FILE *fp)
+/* directories of a log by size */
+static int index_log(const char* log, tree_t* t, sizes_t* s)
 {
-    char line[MAX_LINE_SIZE];
-    int i = depth++;
+    FILE* fp = fopen(log, "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", log);
+        return 0;
+    }
+    char* block = malloc(LOG_BLOCK_SIZE);
+    int ok = (block != NULL) && tree_read(t, fp, block, LOG_BLOCK_SIZE);
+    free(block);
+    fclose(fp);
+    if (!ok)
+    {
+        fprintf(stderr, "\nCould not parse file %s!\n", log);
+        return 0;
+    }
 
-    assert(i < MAX_NUM_DIRS);
+    tree_sizes(t);
+    if (!sizes_build(s, t))
+    {
+        fprintf(stderr, "Not enough memory!\n");
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Reproducible by a fixed seed: a chain of directories down to the depth,
+ * then a random walk up and down creating the others. Each directory has a
+ * file and is listed when it is entered.
+ */
+static int generate(const char* name, unsigned long long dirs, unsigned long long depth)
+{
+    FILE* fp = fopen(name, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return EXIT_FAILURE;
+    }
 
-    while (fgets(line, MAX_LINE_SIZE, fp))
+    static char buf[GEN_BUFFER_SIZE];
+    size_t used = (size_t) sprintf(buf, "$ cd /\n$ ls\n%u r\n", (unsigned) random_below(GEN_FILE_SIZE));
+    unsigned long long level = 0U;
+    int ok = 1;
+    for (unsigned long long d = 1U; ok && (d < dirs); d++)
     {
-        if (line[0] == '$') /* identify command */
+        /* up some levels, but not before the chain is complete */
+        if (d > depth)
         {
-            size_t cmdlen = strlen(line);
-            assert(cmdlen >= 3U);
-            if (line[2] == 'c') /* identify cd */
+            for (size_t up = random_below(3U); (up > 0U) && (level > 0U); up--)
+            {
+                used += (size_t) sprintf(&buf[used], "$ cd ..\n");
+                level--;
+            }
+            while (level >= depth)
             {
-                assert(cmdlen >= 6U);
-                if (line[5] == '.') /* change up */
-                {
-                    break;
-                }
-                else /* enter dir */
-                {
-                    /* accumulate all directory sizes */
-                    dir_sizes[i] += scan_dirs_recursively(fp);
-                }
+                used += (size_t) sprintf(&buf[used], "$ cd ..\n");
+                level--;
             }
-            /* ignore ls */
         }
-        else if ((line[0] >= '0') && (line[0] <= '9'))
+        used += (size_t) sprintf(&buf[used], "$ cd d%llu\n$ ls\n%u f\n", d,
+                                 (unsigned) random_below(GEN_FILE_SIZE));
+        level++;
+
+        if (used > (GEN_BUFFER_SIZE / 2U))
         {
-            int dir_size = 0;
-            if (sscanf(line, "%d", &dir_size) == 1)
-                dir_sizes[i] += dir_size;
+            ok = (fwrite(buf, 1U, used, fp) == used);
+            used = 0U;
         }
-        /* ignore dir */
     }
+    ok = ok && (fwrite(buf, 1U, used, fp) == used);
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "Could not write file %s!\n", name);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
 
-    return dir_sizes[i];
+/* xorshift64, https://en.wikipedia.org/wiki/Xorshift */
+static size_t random_below(size_t n)
+{
+    static unsigned long long rng = 88172645463325252U;
+
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+
+    return (size_t)((rng >> 8) % n);
+}
+
+static double elapsed_s(const struct timespec* t0, const struct timespec* t1)
+{
+    return (double)(t1->tv_sec - t0->tv_sec) + ((double)(t1->tv_nsec - t0->tv_nsec) / 1e9);
 }
@@ -0,0 +1,66 @@
+/*
+ * Day 7 - module to look up directories by their sizes.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "sizes.h"
+
+static int compare_entries(const void* a, const void* b);
+
+int sizes_build(sizes_t* s, const tree_t* t)
+{
+    s->entry = malloc(t->num * sizeof(entry_t));
+    s->num = 0U;
+    if (s->entry == NULL)
+        return 0;
+
+    for (size_t i = 0U; i < t->num; i++)
+    {
+        s->entry[i].size = t->node[i].size;
+        s->entry[i].id = (uint32_t) i;
+    }
+    s->num = t->num;
+    qsort(s->entry, s->num, sizeof(entry_t), compare_entries);
+
+    return 1;
+}
+
+void sizes_free(sizes_t* s)
+{
+    free(s->entry);
+    s->entry = NULL;
+    s->num = 0U;
+}
+
+const entry_t* sizes_smallest(const sizes_t* s, unsigned long long size)
+{
+    /* first entry not smaller */
+    size_t lo = 0U;
+    size_t hi = s->num;
+    while (lo < hi)
+    {
+        size_t mid = lo + ((hi - lo) / 2U);
+        if (s->entry[mid].size < size)
+            lo = mid + 1U;
+        else
+            hi = mid;
+    }
+
+    return (lo < s->num) ? &s->entry[lo] : NULL;
+}
+
+/* by size, equal ones by node */
+static int compare_entries(const void* a, const void* b)
+{
+    const entry_t* arg1 = a;
+    const entry_t* arg2 = b;
+
+    if (arg1->size != arg2->size)
+        return (arg1->size < arg2->size) ? -1 : 1;
+
+    return (arg1->id < arg2->id) ? -1 : (arg1->id > arg2->id);
+}
@@ -0,0 +1,36 @@
+/*
+ * Day 7 - module to look up directories by their sizes.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef SIZES_H_
+#define SIZES_H_
+
+#include "tree.h"
+
+typedef struct
+{
+    unsigned long long size;
+    uint32_t id;               /* node of the directory */
+} entry_t;
+
+/* directories sorted by size */
+typedef struct
+{
+    entry_t* entry;
+    size_t num;
+} sizes_t;
+
+/* index all directories of a tree after tree_sizes(), returns 0 if there is not enough memory */
+int sizes_build(sizes_t* s, const tree_t* t);
+
+void sizes_free(sizes_t* s);
+
+/* smallest directory of at least the given size by binary search, NULL if there is none */
+const entry_t* sizes_smallest(const sizes_t* s, unsigned long long size);
+
+#endif /* SIZES_H_ */
@@ -0,0 +1,474 @@
+/*
+ * Day 7 - module to rebuild the directory tree of a terminal log.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "tree.h"
+
+#include <limits.h>
+#include <string.h>
+
+#define MIN_NODES (1024U)
+#define MIN_NAMES (16384U)
+#define MAX_NODES (UINT32_MAX)
+#define MAGIC     "aoc22 day07 tree"
+
+/* start of a saved tree, followed by the nodes and names */
+typedef struct
+{
+    char magic[sizeof(MAGIC)];
+    unsigned long long node_size;  /* of this build */
+    unsigned long long num;
+    unsigned long long names_used;
+    unsigned long long offset;
+    unsigned long long line;
+    uint32_t cwd;
+    int listing;
+} header_t;
+
+static int read_lines(tree_t* t, FILE* fp, char* block, size_t size, unsigned long long* offset);
+static int read_blocks(tree_t* t, FILE* fp, char* block, size_t size, unsigned long long* offset);
+static int parse_line(tree_t* t, const char* line, size_t len);
+static void add_file(tree_t* t, unsigned long long size);
+static int change_dir(tree_t* t, const char* name, size_t len);
+static size_t find(const tree_t* t, uint32_t parent, const char* name, size_t len, uint32_t* id);
+static size_t hash(uint32_t parent, const char* name, size_t len);
+static int reserve(tree_t* t, size_t len);
+static int reserve_nodes(tree_t* t, size_t num, size_t names);
+static int rehash(tree_t* t, size_t slots);
+
+int tree_init(tree_t* t)
+{
+    t->node = malloc(MIN_NODES * sizeof(node_t));
+    t->capacity = MIN_NODES;
+    t->names = malloc(MIN_NAMES);
+    t->names_size = MIN_NAMES;
+    t->slot = calloc(2U * MIN_NODES, sizeof(uint32_t));
+    t->slots = 2U * MIN_NODES;
+    if ((t->node == NULL) || (t->names == NULL) || (t->slot == NULL))
+    {
+        tree_free(t);
+        return 0;
+    }
+    tree_clear(t);
+
+    return 1;
+}
+
+void tree_clear(tree_t* t)
+{
+    node_t* root = &t->node[TREE_ROOT];
+    root->parent = TREE_ROOT;
+    root->depth = 0U;
+    root->name_length = 0U;
+    root->name = 0U;
+    root->files = 0U;
+    root->size = 0U;
+    root->listed = 0;
+    t->num = 1U;
+    t->names_used = 0U;
+    memset(t->slot, 0, t->slots * sizeof(uint32_t));
+    t->cwd = TREE_ROOT;
+    t->listing = 0;
+    t->live = 0;
+    t->budget = 0U;
+    t->stale = 0;
+    t->line = 1U;
+}
+
+void tree_free(tree_t* t)
+{
+    free(t->node);
+    free(t->names);
+    free(t->slot);
+    t->node = NULL;
+    t->names = NULL;
+    t->slot = NULL;
+}
+
+int tree_parse(tree_t* t, const char* text, size_t n)
+{
+    size_t i = 0U;
+    while (i < n)
+    {
+        const char* eol = memchr(&text[i], '\n', n - i);
+        size_t end = (eol != NULL) ? (size_t)(eol - text) : n;
+        size_t len = end - i;
+        if ((len > 0U) && (text[end - 1U] == '\r'))
+            len--;
+
+        if (!parse_line(t, &text[i], len))
+            return 0;
+        t->line++;
+        i = end + 1U;
+    }
+
+    return 1;
+}
+
+int tree_read(tree_t* t, FILE* fp, char* block, size_t size)
+{
+    return read_lines(t, fp, block, size, NULL);
+}
+
+int tree_follow(tree_t* t, FILE* fp, char* block, size_t size, unsigned long long* offset)
+{
+    return read_lines(t, fp, block, size, offset);
+}
+
+/*
+ * Nodes are created after their parents, so going through them backwards each
+ * one is complete before it is added to its parent, as by a post-order walk.
+ */
+void tree_sizes(tree_t* t)
+{
+    for (size_t i = 0U; i < t->num; i++)
+        t->node[i].size = t->node[i].files;
+    for (size_t i = t->num - 1U; i > TREE_ROOT; i--)
+        t->node[t->node[i].parent].size += t->node[i].size;
+}
+
+void tree_live(tree_t* t)
+{
+    tree_sizes(t);
+    t->live = 1;
+}
+
+int tree_save(const tree_t* t, FILE* fp, unsigned long long offset)
+{
+    header_t h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.node_size = sizeof(node_t);
+    h.num = t->num;
+    h.names_used = t->names_used;
+    h.offset = offset;
+    h.line = t->line;
+    h.cwd = t->cwd;
+    h.listing = t->listing;
+
+    return    (fwrite(&h, sizeof(h), 1U, fp) == 1U)
+           && (fwrite(t->node, sizeof(node_t), t->num, fp) == t->num)
+           && (fwrite(t->names, 1U, t->names_used, fp) == t->names_used);
+}
+
+int tree_load(tree_t* t, FILE* fp, unsigned long long* offset)
+{
+    header_t h;
+    tree_clear(t);
+    if (   (fread(&h, sizeof(h), 1U, fp) != 1U)
+        || (memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0)
+        || (h.node_size != sizeof(node_t))
+        || (h.num == 0U)
+        || (h.num > MAX_NODES)
+        || (h.cwd >= h.num)
+        || !reserve_nodes(t, (size_t) h.num, (size_t) h.names_used)
+        || (fread(t->node, sizeof(node_t), (size_t) h.num, fp) != h.num)
+        || (fread(t->names, 1U, (size_t) h.names_used, fp) != h.names_used))
+    {
+        tree_clear(t);
+        return 0;
+    }
+    t->num = (size_t) h.num;
+    t->names_used = (size_t) h.names_used;
+
+    /* nodes refer to parents before them and names within */
+    if ((t->node[TREE_ROOT].parent != TREE_ROOT) || (t->node[TREE_ROOT].depth != 0U))
+    {
+        tree_clear(t);
+        return 0;
+    }
+    for (size_t i = TREE_ROOT + 1U; i < t->num; i++)
+    {
+        const node_t* node = &t->node[i];
+        if (   (node->parent >= i)
+            || (node->depth != (t->node[node->parent].depth + 1U))
+            || (node->name > t->names_used)
+            || (node->name_length > (t->names_used - node->name)))
+        {
+            tree_clear(t);
+            return 0;
+        }
+    }
+
+    size_t slots = t->slots;
+    while ((2U * (t->num + 1U)) > slots)
+        slots *= 2U;
+    if (!rehash(t, slots))
+    {
+        tree_clear(t);
+        return 0;
+    }
+    t->cwd = h.cwd;
+    t->listing = h.listing;
+    t->live = 1;
+    t->line = h.line;
+    *offset = h.offset;
+
+    return 1;
+}
+
+/* live sizes are added up at the end if the files would take longer */
+static int read_lines(tree_t* t, FILE* fp, char* block, size_t size, unsigned long long* offset)
+{
+    t->budget = t->num;
+    t->stale = 0;
+    int ok = read_blocks(t, fp, block, size, offset);
+    if (t->stale)
+        tree_sizes(t);
+    t->stale = 0;
+
+    return ok;
+}
+
+/* with offset only complete lines are parsed and counted */
+static int read_blocks(tree_t* t, FILE* fp, char* block, size_t size, unsigned long long* offset)
+{
+    /* all complete lines of a block are parsed, the rest is moved to the front */
+    size_t used = 0U;
+    size_t n;
+    while ((n = fread(&block[used], 1U, size - used, fp)) > 0U)
+    {
+        used += n;
+        const char* eol = NULL;
+        for (size_t i = used; i > 0U; i--)
+        {
+            if (block[i - 1U] == '\n')
+            {
+                eol = &block[i - 1U];
+                break;
+            }
+        }
+        if (eol == NULL)
+        {
+            if (used < size)
+                continue;
+            fprintf(stderr, "Line %llu is too long!", t->line);
+            return 0;
+        }
+
+        size_t lines = (size_t)(eol - block) + 1U;
+        if (!tree_parse(t, block, lines))
+            return 0;
+        if (offset != NULL)
+            *offset += lines;
+        used -= lines;
+        memmove(block, &block[lines], used);
+    }
+    if (ferror(fp))
+    {
+        fprintf(stderr, "Could not read input!");
+        return 0;
+    }
+
+    return (offset != NULL) || tree_parse(t, block, used); /* no line end */
+}
+
+static int parse_line(tree_t* t, const char* line, size_t len)
+{
+    if ((len >= 5U) && (memcmp(line, "$ cd ", 5U) == 0))
+    {
+        t->listing = 0;
+        return change_dir(t, &line[5], len - 5U);
+    }
+    if ((len == 4U) && (memcmp(line, "$ ls", 4U) == 0))
+    {
+        t->listing = !t->node[t->cwd].listed;
+        t->node[t->cwd].listed = 1;
+        return 1;
+    }
+    if ((len > 4U) && (memcmp(line, "dir ", 4U) == 0))
+        return 1;
+
+    /* "size name" */
+    unsigned long long size = 0U;
+    size_t i = 0U;
+    for (; (i < len) && (line[i] >= '0') && (line[i] <= '9'); i++)
+    {
+        unsigned long long digit = (unsigned long long)(line[i] - '0');
+        if (size > ((ULLONG_MAX - digit) / 10U))
+            break;
+        size = (size * 10U) + digit;
+    }
+    if ((i == 0U) || ((i + 1U) >= len) || (line[i] != ' '))
+    {
+        fprintf(stderr, "Unexpected data in line %llu!", t->line);
+        return 0;
+    }
+    if (t->listing)
+        add_file(t, size);
+
+    return 1;
+}
+
+static void add_file(tree_t* t, unsigned long long size)
+{
+    t->node[t->cwd].files += size;
+    if (!t->live || t->stale)
+        return;
+    if (t->node[t->cwd].depth >= t->budget)
+    {
+        t->stale = 1;
+        return;
+    }
+    t->budget -= t->node[t->cwd].depth + 1U;
+
+    for (uint32_t id = t->cwd; ; id = t->node[id].parent)
+    {
+        t->node[id].size += size;
+        if (id == TREE_ROOT)
+            break;
+    }
+}
+
+static int change_dir(tree_t* t, const char* name, size_t len)
+{
+    if ((len == 1U) && (name[0] == '/'))
+    {
+        t->cwd = TREE_ROOT;
+        return 1;
+    }
+    if ((len == 2U) && (name[0] == '.') && (name[1] == '.'))
+    {
+        t->cwd = t->node[t->cwd].parent;
+        return 1;
+    }
+    if ((len == 0U) || (memchr(name, '/', len) != NULL))
+    {
+        fprintf(stderr, "Unexpected directory in line %llu!", t->line);
+        return 0;
+    }
+
+    uint32_t id;
+    size_t s = find(t, t->cwd, name, len, &id);
+    if (id != TREE_ROOT)
+    {
+        t->cwd = id;
+        return 1;
+    }
+
+    /* a new directory */
+    if (t->num >= MAX_NODES)
+    {
+        fprintf(stderr, "Too many directories in line %llu!", t->line);
+        return 0;
+    }
+    if (!reserve(t, len))
+    {
+        fprintf(stderr, "Not enough memory!");
+        return 0;
+    }
+    s = find(t, t->cwd, name, len, &id); /* the index may have grown */
+
+    node_t* node = &t->node[t->num];
+    node->parent = t->cwd;
+    node->depth = t->node[t->cwd].depth + 1U;
+    node->name_length = (uint32_t) len;
+    node->name = t->names_used;
+    node->files = 0U;
+    node->size = 0U;
+    node->listed = 0;
+    memcpy(&t->names[t->names_used], name, len);
+    t->names_used += len;
+    t->slot[s] = (uint32_t) t->num;
+    t->cwd = (uint32_t) t->num++;
+
+    return 1;
+}
+
+/* slot of the directory, id is TREE_ROOT if it is not there yet */
+static size_t find(const tree_t* t, uint32_t parent, const char* name, size_t len, uint32_t* id)
+{
+    size_t s = hash(parent, name, len) & (t->slots - 1U);
+    for (;; s = (s + 1U) & (t->slots - 1U))
+    {
+        uint32_t k = t->slot[s];
+        const node_t* node = &t->node[k];
+        if (   (k == TREE_ROOT)
+            || (   (node->parent == parent)
+                && (node->name_length == len)
+                && (memcmp(&t->names[node->name], name, len) == 0)))
+        {
+            *id = k;
+            return s;
+        }
+    }
+}
+
+/* FNV-1a, https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function */
+static size_t hash(uint32_t parent, const char* name, size_t len)
+{
+    unsigned long long h = 14695981039346656037U ^ parent;
+    for (size_t i = 0U; i < len; i++)
+    {
+        h ^= (unsigned char) name[i];
+        h *= 1099511628211U;
+    }
+
+    return (size_t)(h ^ (h >> 32));
+}
+
+/* room for another node of a name of len characters, the index stays half empty */
+static int reserve(tree_t* t, size_t len)
+{
+    if (!reserve_nodes(t, t->num + 1U, t->names_used + len))
+        return 0;
+    if ((2U * (t->num + 1U)) > t->slots)
+        return rehash(t, 2U * t->slots);
+
+    return 1;
+}
+
+/* room for num nodes and names of the given size */
+static int reserve_nodes(tree_t* t, size_t num, size_t names)
+{
+    if (num > t->capacity)
+    {
+        size_t capacity = 2U * t->capacity;
+        while (num > capacity)
+            capacity *= 2U;
+        node_t* node = realloc(t->node, capacity * sizeof(node_t));
+        if (node == NULL)
+            return 0;
+        t->node = node;
+        t->capacity = capacity;
+    }
+    if (names > t->names_size)
+    {
+        size_t size = 2U * t->names_size;
+        while (names > size)
+            size *= 2U;
+        char* grown = realloc(t->names, size);
+        if (grown == NULL)
+            return 0;
+        t->names = grown;
+        t->names_size = size;
+    }
+
+    return 1;
+}
+
+static int rehash(tree_t* t, size_t slots)
+{
+    uint32_t* slot = calloc(slots, sizeof(uint32_t));
+    if (slot == NULL)
+        return 0;
+
+    free(t->slot);
+    t->slot = slot;
+    t->slots = slots;
+    for (size_t i = TREE_ROOT + 1U; i < t->num; i++)
+    {
+        const node_t* node = &t->node[i];
+        size_t s = hash(node->parent, &t->names[node->name], node->name_length) & (slots - 1U);
+        while (slot[s] != TREE_ROOT)
+            s = (s + 1U) & (slots - 1U);
+        slot[s] = (uint32_t) i;
+    }
+
+    return 1;
+}
@@ -0,0 +1,102 @@
+/*
+ * Day 7 - module to rebuild the directory tree of a terminal log.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef TREE_H_
+#define TREE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TREE_ROOT (0U)  /* node of "/" */
+
+typedef struct
+{
+    uint32_t parent;           /* root is its own parent */
+    uint32_t depth;            /* 0 for root */
+    uint32_t name_length;
+    size_t name;               /* offset into the names */
+    unsigned long long files;  /* sizes of the files directly in it */
+    unsigned long long size;   /* of everything in it, after tree_sizes() or if live */
+    int listed;                /* files have been counted */
+} node_t;
+
+/*
+ * Nodes live in one array, a node is always created after its parent. They
+ * are found by parent and name in a hash index.
+ */
+typedef struct
+{
+    node_t* node;
+    size_t num;
+    size_t capacity;
+    char* names;
+    size_t names_used;
+    size_t names_size;
+    uint32_t* slot;            /* open addressing, 0 is empty as root is nobody's child */
+    size_t slots;              /* power of 2 */
+    uint32_t cwd;              /* current working directory */
+    int listing;               /* lines are the output of "ls" to be counted */
+    int live;                  /* sizes of all ancestors follow each file */
+    unsigned long long budget; /* ancestors left to update by files of a read */
+    int stale;                 /* sizes are added up at the end of a read */
+    unsigned long long line;   /* number of the next line, starting at 1 */
+} tree_t;
+
+/* only the root, returns 0 if there is not enough memory */
+int tree_init(tree_t* t);
+
+/* back to only the root, not live, the memory is kept */
+void tree_clear(tree_t* t);
+
+void tree_free(tree_t* t);
+
+/*
+ * Follow the commands "$ cd name", "$ cd ..", "$ cd /" and "$ ls" of complete
+ * lines, the last one may lack its line end, and count the file sizes listed.
+ * A directory listed again is not counted twice, "dir name" is ignored as it
+ * is created when it is entered. Returns 0 on unexpected data, the line is
+ * reported on stderr, or if there is not enough memory.
+ */
+int tree_parse(tree_t* t, const char* text, size_t n);
+
+/*
+ * Parse a whole log by tree_parse() block by block, a line has to fit into the
+ * block. Returns 0 like tree_parse() or on read errors.
+ */
+int tree_read(tree_t* t, FILE* fp, char* block, size_t size);
+
+/*
+ * Same as tree_read() for a log which is still written to: a last line without
+ * line end is left for later. The bytes of the lines parsed are added to
+ * offset, which is where to continue.
+ */
+int tree_follow(tree_t* t, FILE* fp, char* block, size_t size, unsigned long long* offset);
+
+/* total size of each directory */
+void tree_sizes(tree_t* t);
+
+/*
+ * Get the total sizes and keep them from now on: each file is added to the
+ * sizes of its directory and all ancestors, which takes the depth. Once the
+ * files read at once would take longer than adding up all sizes again, this
+ * is done at the end of the read instead.
+ */
+void tree_live(tree_t* t);
+
+/* write the tree and the offset into its log, returns 0 on errors */
+int tree_save(const tree_t* t, FILE* fp, unsigned long long offset);
+
+/*
+ * Read a tree written by tree_save(), its index is rebuilt. Returns 0 if it is
+ * no tree of this program or on errors, the tree is cleared then.
+ */
+int tree_load(tree_t* t, FILE* fp, unsigned long long* offset);
+
+#endif /* TREE_H_ */
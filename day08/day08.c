@@ -0,0 +1,262 @@
+/*
+ * Solver for advent of code 2022 day 8.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day08.h"
+
+#include "grid.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEIGHTS (10U) /* trees are '0' to '9' high */
+
+/*
+ * Every direction is looked at by one pass over the rows. A pass keeps the
+ * trees which block the view into it, each higher than the ones after it, so
+ * there are at most one per height. A tree hides the lower ones behind it,
+ * sees up to the next one left and is visible from the edge if none is left.
+ * Rows are looked along in place, columns by keeping one sight per column
+ * while going down or up the rows.
+ */
+typedef struct
+{
+    size_t at;   /* steps from the edge the pass starts at */
+    char tree;
+} blocker_t;
+
+typedef struct
+{
+    blocker_t blocker[HEIGHTS];
+    size_t used;
+} sight_t;
+
+typedef struct
+{
+    grid_t grid;
+    unsigned char* visible;     /* per tree: seen from any edge so far */
+    unsigned long long* score;  /* per tree: product of the views so far */
+    size_t trees;               /* capacity of visible and score */
+    sight_t* sights;            /* per column */
+    size_t columns;             /* capacity of sights */
+} state_t;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+static int reserve(state_t* s);
+static size_t look(sight_t* sight, char tree, size_t at, unsigned char* visible);
+static int look_along_rows(state_t* s);
+static void look_from_top(state_t* s);
+static void look_from_bottom(state_t* s, size_t* visible_trees, unsigned long long* view);
+
+const solver_t day08_solver =
+{
+    .name = "day08",
+    .title = "Day 8: Treetop Tree House",
+    .part =
+    {
+        "number of visible trees from outside",
+        "highest scenic score"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s != NULL)
+    {
+        grid_init(&s->grid);
+        s->visible = NULL;
+        s->score = NULL;
+        s->trees = 0U;
+        s->sights = NULL;
+        s->columns = 0U;
+    }
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+
+    (void) log;
+
+    /* heights are kept as digits, they compare the same way */
+    if (!grid_read(&s->grid, fp, 0U, '0'))
+    {
+        fprintf(stderr, "Could not read map of trees!\n");
+        return 0;
+    }
+    if (!reserve(s))
+    {
+        fprintf(stderr, "Not enough memory!\n");
+        return 0;
+    }
+    if (!look_along_rows(s))
+    {
+        fprintf(stderr, "Invalid height of tree!\n");
+        return 0;
+    }
+
+    size_t visible_trees = 0U;
+    unsigned long long view = 0U;
+    look_from_top(s);
+    look_from_bottom(s, &visible_trees, &view);
+
+    solver_answer(result, 1U, "%llu", (unsigned long long) visible_trees);
+    solver_answer(result, 2U, "%llu", view);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    grid_free(&s->grid);
+    free(s->visible);
+    free(s->score);
+    free(s->sights);
+    free(s);
+}
+
+static int reserve(state_t* s)
+{
+    size_t trees = s->grid.width * s->grid.height;
+    if (trees > s->trees)
+    {
+        unsigned char* visible = malloc(trees * sizeof(unsigned char));
+        unsigned long long* score = malloc(trees * sizeof(unsigned long long));
+        if ((visible == NULL) || (score == NULL))
+        {
+            free(visible);
+            free(score);
+            return 0;
+        }
+        free(s->visible);
+        free(s->score);
+        s->visible = visible;
+        s->score = score;
+        s->trees = trees;
+    }
+
+    if (s->grid.width > s->columns)
+    {
+        sight_t* sights = malloc(s->grid.width * sizeof(sight_t));
+        if (sights == NULL)
+            return 0;
+        free(s->sights);
+        s->sights = sights;
+        s->columns = s->grid.width;
+    }
+
+    return 1;
+}
+
+/* returns the view of the tree at the given step, and adds it to the sight */
+static size_t look(sight_t* sight, char tree, size_t at, unsigned char* visible)
+{
+    while ((sight->used > 0U) && (sight->blocker[sight->used - 1U].tree < tree))
+        sight->used--;
+
+    size_t view = at;
+    if (sight->used == 0U)
+    {
+        *visible = 1U;
+    }
+    else
+    {
+        view -= sight->blocker[sight->used - 1U].at;
+        if (sight->blocker[sight->used - 1U].tree == tree)
+            sight->used--;
+    }
+
+    sight->blocker[sight->used].at = at;
+    sight->blocker[sight->used].tree = tree;
+    sight->used++;
+
+    return view;
+}
+
+/* initializes visible and score by the views to the left and right */
+static int look_along_rows(state_t* s)
+{
+    const grid_t* g = &s->grid;
+    const size_t width = g->width;
+
+    for (size_t y = 0U; y < g->height; y++)
+    {
+        const char* row = grid_at(g, 0, (ptrdiff_t) y);
+        unsigned char* visible = &s->visible[y * width];
+        unsigned long long* score = &s->score[y * width];
+        sight_t sight;
+
+        sight.used = 0U;
+        for (size_t x = 0U; x < width; x++)
+        {
+            if ((row[x] < '0') || (row[x] > '9'))
+                return 0;
+            visible[x] = 0U;
+            score[x] = look(&sight, row[x], x, &visible[x]);
+        }
+
+        sight.used = 0U;
+        for (size_t x = width; x-- > 0U; )
+            score[x] *= look(&sight, row[x], width - 1U - x, &visible[x]);
+    }
+
+    return 1;
+}
+
+static void look_from_top(state_t* s)
+{
+    const grid_t* g = &s->grid;
+    const size_t width = g->width;
+
+    for (size_t x = 0U; x < width; x++)
+        s->sights[x].used = 0U;
+
+    for (size_t y = 0U; y < g->height; y++)
+    {
+        const char* row = grid_at(g, 0, (ptrdiff_t) y);
+        unsigned char* visible = &s->visible[y * width];
+        unsigned long long* score = &s->score[y * width];
+        for (size_t x = 0U; x < width; x++)
+            score[x] *= look(&s->sights[x], row[x], y, &visible[x]);
+    }
+}
+
+/* completes visible and score, and sums them up */
+static void look_from_bottom(state_t* s, size_t* visible_trees, unsigned long long* view)
+{
+    const grid_t* g = &s->grid;
+    const size_t width = g->width;
+
+    for (size_t x = 0U; x < width; x++)
+        s->sights[x].used = 0U;
+
+    for (size_t y = g->height; y-- > 0U; )
+    {
+        const char* row = grid_at(g, 0, (ptrdiff_t) y);
+        unsigned char* visible = &s->visible[y * width];
+        unsigned long long* score = &s->score[y * width];
+        for (size_t x = 0U; x < width; x++)
+        {
+            score[x] *= look(&s->sights[x], row[x], g->height - 1U - y, &visible[x]);
+            *visible_trees += visible[x];
+            if (score[x] > *view)
+                *view = score[x];
+        }
+    }
+}
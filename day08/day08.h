@@ -0,0 +1,17 @@
+/*
+ * Solver for advent of code 2022 day 8.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY08_H_
+#define DAY08_H_
+
+#include "solver.h"
+
+extern const solver_t day08_solver;
+
+#endif /* DAY08_H_ */
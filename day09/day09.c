@@ -0,0 +1,285 @@
+/*
+ * Solver for advent of code 2022 day 9.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day09.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define MAX_LINE_SIZE (16)
+
+typedef struct
+{
+    int32_t x;
+    int32_t y;
+} pos_t;
+
+typedef union
+{
+    pos_t pos;
+    int64_t code;
+} visited_t;
+
+typedef struct
+{
+    visited_t *positions;
+    size_t used;
+    size_t size;
+} track_t;
+
+typedef struct
+{
+    track_t track_p1;
+    track_t track_p2;
+} state_t;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+
+static int compare_codes(const void* a, const void* b);
+
+static int initTrack(track_t* t, size_t size);
+static int addPosition(track_t* t, visited_t pos);
+static void freeTrack(track_t* t);
+
+static void move_head(char dir, pos_t* pos);
+static int move_tail(visited_t head, visited_t* tail);
+
+const solver_t day09_solver =
+{
+    .name = "day09",
+    .title = "Day 9: Rope Bridges",
+    .part =
+    {
+        "Unique positions of tail",
+        "Unique positions of tail"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->track_p2.positions = NULL;
+    if (!initTrack(&s->track_p1, 100) || !initTrack(&s->track_p2, 100))
+    {
+        destroy(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    track_t* track_p1 = &s->track_p1;
+    track_t* track_p2 = &s->track_p2;
+
+    (void) log;
+
+    char line_buf[MAX_LINE_SIZE] = {0};
+
+    track_p1->used = 0U;
+    track_p2->used = 0U;
+
+    visited_t head = {0};
+    visited_t tail_p1 = {0};
+    visited_t tail_p2[9] = {0};
+
+    if (!addPosition(track_p1, tail_p1) || !addPosition(track_p2, tail_p2[0]))
+    {
+        fprintf(stderr, "Not enough memory!");
+        return 0;
+    }
+    while (fgets(line_buf, MAX_LINE_SIZE, fp))
+    {
+        char dir = 'x';
+        int steps = 0;
+        if (line_buf[strspn(line_buf, " \r\n")] == '\0')
+            continue; /* empty line */
+        if (   (sscanf(line_buf, "%c %d", &dir, &steps) != 2)
+            || (strchr("URDL", dir) == NULL) || (dir == '\0') || (steps < 0))
+        {
+            fprintf(stderr, "Invalid motion: %s", line_buf);
+            return 0;
+        }
+        while (steps > 0)
+        {
+            /* part 1 */
+            move_head(dir, &head.pos);
+            int added = 1;
+            if (move_tail(head, &tail_p1))
+                added = addPosition(track_p1, tail_p1);
+            /* part 2 */
+            move_tail(head, &tail_p2[0]);
+            for(int n = 1; n < 8; n++)
+                move_tail(tail_p2[n - 1], &tail_p2[n]);
+            if (move_tail(tail_p2[7], &tail_p2[8]) && added)
+                added = addPosition(track_p2, tail_p2[8]);
+            if (!added)
+            {
+                fprintf(stderr, "Not enough memory!");
+                return 0;
+            }
+            steps--;
+        }
+    }
+
+    qsort(track_p1->positions, track_p1->used, sizeof(visited_t), compare_codes);
+    qsort(track_p2->positions, track_p2->used, sizeof(visited_t), compare_codes);
+
+    int unique = 1;
+    for (size_t i = 1U; i < track_p1->used; i++)
+        if (track_p1->positions[i].code > track_p1->positions[i - 1U].code)
+            unique++;
+    solver_answer(result, 1U, "%d", unique);
+
+    unique = 1;
+    for (size_t i = 1U; i < track_p2->used; i++)
+        if (track_p2->positions[i].code > track_p2->positions[i - 1U].code)
+            unique++;
+    solver_answer(result, 2U, "%d", unique);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    freeTrack(&s->track_p1);
+    freeTrack(&s->track_p2);
+    free(s);
+}
+
+static int compare_codes(const void* a, const void* b)
+{
+    int64_t arg1 = *(const int64_t*)a;
+    int64_t arg2 = *(const int64_t*)b;
+
+    if (arg1 < arg2)
+        return -1;
+
+    if (arg1 > arg2)
+        return 1;
+
+    return 0;
+}
+
+static int initTrack(track_t* t, size_t size)
+{
+    t->positions = malloc(size * sizeof(visited_t));
+    t->used = 0U;
+    t->size = (t->positions != NULL) ? size : 0U;
+    return t->positions != NULL;
+}
+
+static int addPosition(track_t* t, visited_t pos)
+{
+    if (t->used >= t->size)
+    {
+        size_t size = (t->size > 0U) ? (t->size * 2U) : 100U;
+        visited_t* positions = realloc(t->positions, size * sizeof(visited_t));
+        if (positions == NULL)
+            return 0;
+        t->positions = positions;
+        t->size = size;
+    }
+    t->positions[t->used++] = pos;
+    return 1;
+}
+
+static void freeTrack(track_t* t)
+{
+    free(t->positions);
+    t->positions = NULL;
+    t->used = 0U;
+    t->size = 0U;
+}
+
+static void move_head(char dir, pos_t* pos)
+{
+    switch (dir)
+    {
+        case 'U':
+            pos->y--;
+            break;
+        case 'R':
+            pos->x++;
+            break;
+        case 'D':
+            pos->y++;
+            break;
+        case 'L':
+            pos->x--;
+            break;
+        default:
+            assert(0);
+    }
+}
+
+static int move_tail(visited_t head, visited_t* tail)
+{
+    if (tail->pos.y - head.pos.y > 1) /* up */
+    {
+        tail->pos.y--;
+        if ((tail->pos.x - head.pos.x) > 1) /* diag left */
+            tail->pos.x--;
+        else if ((head.pos.x - tail->pos.x) > 1) /* diag right */
+            tail->pos.x++;
+        else
+            tail->pos.x = head.pos.x;
+    }
+    else if (head.pos.y - tail->pos.y > 1) /* down */
+    {
+        tail->pos.y++;
+        if ((tail->pos.x - head.pos.x) > 1) /* diag left */
+            tail->pos.x--;
+        else if ((head.pos.x - tail->pos.x) > 1) /* diag right */
+            tail->pos.x++;
+        else
+            tail->pos.x = head.pos.x;
+    }
+    else if (tail->pos.x - head.pos.x > 1) /* left */
+    {
+        tail->pos.x--;
+        if ((tail->pos.y - head.pos.y) > 1) /* diag up */
+            tail->pos.y--;
+        else if ((head.pos.y - tail->pos.y) > 1) /* diag down */
+            tail->pos.y++;
+        else
+            tail->pos.y = head.pos.y;
+    }
+    else if (head.pos.x - tail->pos.x > 1) /* right */
+    {
+        tail->pos.x++;
+        if ((tail->pos.y - head.pos.y) > 1) /* diag up */
+            tail->pos.y--;
+        else if ((head.pos.y - tail->pos.y) > 1) /* diag down */
+            tail->pos.y++;
+        else
+            tail->pos.y = head.pos.y;
+    }
+    else
+    {
+        return 0; /* no movement */
+    }
+
+    return 1; /* moved */
+}
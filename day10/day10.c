@@ -0,0 +1,154 @@
+/*
+ * Solver for advent of code 2022 day 10.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+/* spaghetti (>_<) */
+
+#include "day10.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define MAX_LINE_SIZE  (16)
+#define CHECK_FIRST    (20U)
+#define CHECK_INTERVAL (40U)
+#define CRT_X          (40U)
+#define CRT_Y          (6U)
+
+#if ((CRT_X + 1U) * CRT_Y) > SOLVER_ANSWER_SIZE
+#error "CRT does not fit into answer"
+#endif
+
+typedef enum
+{
+    READ_INSTRUCTION,
+    PROCESS_NOOP,
+    PROCESS_ADDX1,
+    PROCESS_ADDX2
+} state_t;
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+
+const solver_t day10_solver =
+{
+    .name = "day10",
+    .title = "Day 10: Cathode-Ray Tube",
+    .part =
+    {
+        "sum of all signal strengths",
+        "CRT"
+    },
+    .create = NULL,
+    .solve = solve,
+    .destroy = NULL
+};
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    (void) state;
+    (void) log;
+
+    char line_buf[MAX_LINE_SIZE] = {0};
+
+    unsigned int cycles = 1U;
+    unsigned int check = CHECK_FIRST;
+    unsigned int result_p1 = 0;
+    int register_x = 1;
+    int num = 0;
+
+    char crt[CRT_Y][CRT_X];
+
+    /* init CRT */
+    for (unsigned int y = 0U; y < CRT_Y; y++)
+        for (unsigned int x = 0U; x < CRT_X; x++)
+            crt[y][x] = '-';
+
+    state_t cpu = READ_INSTRUCTION;
+
+    struct
+    {
+        unsigned int x;
+        unsigned int y;
+    } crt_pos = {0};
+
+    int running = 1;
+    while (running)
+    {
+        if (crt_pos.x >= CRT_X)
+        {
+            crt_pos.x = 0U;
+            crt_pos.y++;
+        }
+        if (((register_x - 1) <= (int)crt_pos.x) && ((register_x + 1) >= (int)crt_pos.x))
+            crt[crt_pos.y % CRT_Y][crt_pos.x] = '#';
+        else
+            crt[crt_pos.y % CRT_Y][crt_pos.x] = '.';
+
+        switch (cpu)
+        {
+            case READ_INSTRUCTION:
+                if (fgets(line_buf, MAX_LINE_SIZE, fp))
+                {
+                    if (line_buf[0] == 'n')
+                        cpu = PROCESS_NOOP;
+                    else if (sscanf(line_buf, "addx %d", &num) == 1)
+                        cpu = PROCESS_ADDX1;
+                    else if (line_buf[strspn(line_buf, " \r\n")] != '\0')
+                    {
+                        fprintf(stderr, "Invalid instruction: %s", line_buf);
+                        return 0;
+                    }
+                }
+                else
+                    running = 0;
+                break;
+            case PROCESS_NOOP:
+                cpu = READ_INSTRUCTION;
+                cycles++;
+                crt_pos.x++;
+                break;
+            case PROCESS_ADDX1:
+                cpu = PROCESS_ADDX2;
+                cycles++;
+                crt_pos.x++;
+                break;
+            case PROCESS_ADDX2:
+                register_x += num;
+                cpu = READ_INSTRUCTION;
+                cycles++;
+                crt_pos.x++;
+                break;
+            default:
+                assert(0);
+        }
+        if (cycles == check)
+        {
+            check += CHECK_INTERVAL;
+            result_p1 += (cycles * register_x);
+        }
+    }
+
+    solver_answer(result, 1U, "%u", result_p1);
+
+    /* rows of the CRT separated by line breaks */
+    char* a = result->answer[1];
+    for (unsigned int y = 0U; y < CRT_Y; y++)
+    {
+        if (y > 0U)
+            *a++ = '\n';
+        memcpy(a, crt[y], CRT_X);
+        a += CRT_X;
+    }
+    *a = '\0';
+    // ZFBFHGUP
+
+    return 1;
+}
@@ -0,0 +1,17 @@
+/*
+ * Solver for advent of code 2022 day 10.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY10_H_
+#define DAY10_H_
+
+#include "solver.h"
+
+extern const solver_t day10_solver;
+
+#endif /* DAY10_H_ */
@@ -0,0 +1,284 @@
+/*
+ * Solver for advent of code 2022 day 11.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+/*
+ * WIP
+ * part 1 solved but currently not working due to preparations for part 2!
+ */
+
+#include "day11.h"
+
+#include "queue.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define MAX_LINE_SIZE  (64)
+#define MAX_MONKEY     (20)
+#define ROUNDS         (10000)
+
+typedef enum
+{
+    ADDITION,
+    MULTIPLICATION
+} operation_t;
+
+typedef enum
+{
+    SELF,
+    VALUE
+} operand_select;
+
+typedef struct
+{
+    queue_t* items;
+    uint64_t divisor;
+    int next_monkey_true;
+    int next_monkey_false;
+    operation_t operation;
+    operand_select opselect;
+    uint64_t operand;
+    int count;
+} monkey_t;
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static int read_monkeys(monkey_t monkeys[], int* num_monkey, FILE* fp);
+static int compare_monkeys(const void* a, const void* b);
+
+const solver_t day11_solver =
+{
+    .name = "day11",
+    .title = "Day 11: Monkey in the Middle",
+    .part =
+    {
+        "level of monkey business",
+        "level of monkey business"
+    },
+    .create = NULL,
+    .solve = solve,
+    .destroy = NULL
+};
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    (void) state;
+
+    int num_monkey = 0;
+    monkey_t monkeys[MAX_MONKEY] = {0};
+    int ok = read_monkeys(monkeys, &num_monkey, fp);
+
+    for (int round = 0; ok && (round < ROUNDS); round++)
+    {
+        for (int m = 0; ok && (m < num_monkey); m++)
+        {
+            uint64_t worrylvl;
+            while( ok && queue_dequeue(monkeys[m].items, &worrylvl) )
+            {
+                uint64_t operand;
+                monkeys[m].count++;
+                switch (monkeys[m].opselect)
+                {
+                    case SELF:
+                        operand = worrylvl;
+                        break;
+                    case VALUE:
+                        operand = monkeys[m].operand;
+                        break;
+                    default:
+                        assert(0);
+                }
+                // uint64_t before = worrylvl;
+                switch(monkeys[m].operation)
+                {
+                    case ADDITION:
+                        worrylvl += operand;
+                        break;
+                    case MULTIPLICATION:
+                        worrylvl *= operand;
+                        break;
+                    default:
+                        assert(0);
+                }
+                // if ( worrylvl < before)
+                //     fprintf(stderr, "%llu %llu %llu\n", before, operand, worrylvl);
+
+                worrylvl /= 3UL;
+                if ((worrylvl % monkeys[m].divisor) == 0UL)
+                    ok = queue_enqueue(monkeys[monkeys[m].next_monkey_true].items, &worrylvl);
+                else
+                    ok = queue_enqueue(monkeys[monkeys[m].next_monkey_false].items, &worrylvl);
+                if (!ok)
+                    fprintf(stderr, "Not enough memory!");
+            }
+        }
+    }
+
+    /* note: monkeys cannot be identified after sort */
+    if (ok)
+        qsort(monkeys, num_monkey, sizeof(monkey_t), compare_monkeys);
+    for (int i = 0; i < num_monkey; i++)
+    {
+        if (ok)
+            solver_log(log, "%d\n", monkeys[i].count);
+        queue_destroy(monkeys[i].items);
+        free(monkeys[i].items);
+    }
+    if (!ok)
+        return 0;
+
+    solver_answer(result, 1U, "%lld", (long long) monkeys[num_monkey-1].count * monkeys[num_monkey-2].count);
+
+    return 1;
+}
+
+static int read_monkeys(monkey_t monkeys[], int* num_monkey, FILE* fp)
+{
+    char line_buf[MAX_LINE_SIZE] = {0};
+    int content = 0; /* a line of the current monkey has been read */
+
+    *num_monkey = 0;
+    while (fgets(line_buf, MAX_LINE_SIZE, fp) != NULL)
+    {
+        size_t len = strcspn(line_buf, "\r\n");
+        line_buf[len] = '\0';
+        if (len == 0U)
+        {
+            content = 0; /* monkeys are separated by empty lines */
+            continue;
+        }
+        if (!content)
+        {
+            if (*num_monkey >= MAX_MONKEY)
+            {
+                fprintf(stderr, "Too many monkeys!");
+                return 0;
+            }
+            monkeys[*num_monkey].items = queue_init(sizeof(int64_t));
+            if (monkeys[*num_monkey].items == NULL)
+            {
+                fprintf(stderr, "Not enough memory!");
+                return 0;
+            }
+            (*num_monkey)++;
+            content = 1;
+        }
+        monkey_t* monkey = &monkeys[*num_monkey - 1];
+        if ((len > 2U) && (line_buf[2] == 'O'))
+        {
+            /*           10        20
+             * 012345678901234567890123456
+             *   Operation: new = old * o/digit
+             *   ^                    ^ ^
+             *              operator -´ `- old or digit
+             */
+            if (len < 26U)
+            {
+                fprintf(stderr, "Invalid operation: %s", line_buf);
+                return 0;
+            }
+            switch (line_buf[23])
+            {
+                case '+':
+                    monkey->operation = ADDITION;
+                    break;
+                case '*':
+                    monkey->operation = MULTIPLICATION;
+                    break;
+                default:
+                    fprintf(stderr, "Invalid operator: %s", line_buf);
+                    return 0;
+            }
+            if (line_buf[25] == 'o') /* old */
+            {
+                monkey->opselect = SELF;
+            }
+            else if (isdigit((unsigned char) line_buf[25]))
+            {
+                monkey->opselect = VALUE;
+                monkey->operand = (uint64_t) atol(&line_buf[25]);
+            }
+            else
+            {
+                fprintf(stderr, "Invalid operand: %s", line_buf);
+                return 0;
+            }
+        }
+        else if ((len > 2U) && (line_buf[2] == 'S'))
+        {
+            char* p = line_buf;
+            while (*p)
+            {
+                if (   isdigit((unsigned char) *p)
+                    || ((*p == '-') && isdigit((unsigned char) *(p+1))) )
+                {
+                    errno = 0;
+                    long v = strtol(p, &p, 10);
+                    if ((errno != 0) || !queue_enqueue(monkey->items, &v))
+                    {
+                        fprintf(stderr, "Invalid item: %s", line_buf);
+                        return 0;
+                    }
+                }
+                else
+                    p++;
+            }
+        }
+        else
+        {
+            /* simple try to parse the other stuff */
+            sscanf(line_buf, "  Test: divisible by %llu", &monkey->divisor);
+            sscanf(line_buf, "    If true: throw to monkey %d", &monkey->next_monkey_true);
+            sscanf(line_buf, "    If false: throw to monkey %d", &monkey->next_monkey_false);
+        }
+    }
+
+    if (*num_monkey < 2)
+    {
+        fprintf(stderr, "At least two monkeys needed!");
+        return 0;
+    }
+    for (int m = 0; m < *num_monkey; m++)
+    {
+        /* an item thrown to the same monkey would be inspected forever */
+        if (   (monkeys[m].divisor == 0U)
+            || (monkeys[m].next_monkey_true < 0)
+            || (monkeys[m].next_monkey_true >= *num_monkey)
+            || (monkeys[m].next_monkey_true == m)
+            || (monkeys[m].next_monkey_false < 0)
+            || (monkeys[m].next_monkey_false >= *num_monkey)
+            || (monkeys[m].next_monkey_false == m))
+        {
+            fprintf(stderr, "Invalid test of monkey %d!", m);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static int compare_monkeys(const void* a, const void* b)
+{
+    monkey_t arg1 = *(const monkey_t*)a;
+    monkey_t arg2 = *(const monkey_t*)b;
+
+    if (arg1.count < arg2.count)
+        return -1;
+
+    if (arg1.count > arg2.count)
+        return 1;
+
+    return 0;
+}
+
+
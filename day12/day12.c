@@ -0,0 +1,306 @@
+/*
+ * Solver for advent of code 2022 day 12.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day12.h"
+
+#include "bitset.h"
+#include "grid.h"
+#include "queue.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define HEIGHT_BORDER ('z' + 4) /* sentinel, too high to be entered */
+
+typedef struct
+{
+    size_t x;
+    size_t y;
+} coords_t;
+
+typedef struct
+{
+    ptrdiff_t pos; /* offset of the cell relative to cell (0, 0) */
+    int distance;
+} path_t;
+
+typedef struct
+{
+    grid_t heightmap;
+    bitset_t visited; /* one bit per cell of the heightmap, incl. border */
+    ptrdiff_t origin; /* bit of cell (0, 0) */
+    coords_t start;
+    coords_t end;
+} map_t;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+
+static int parse_input(FILE* fp, map_t* map);
+
+static void print_grid_map(const map_t* map);
+static void print_grid_visited(const map_t* map);
+
+static int bfs(map_t* map);
+
+static int try_move(queue_t* q, map_t* map, const path_t* p, ptrdiff_t step);
+
+const solver_t day12_solver =
+{
+    .name = "day12",
+    .title = "Day 12: Hill Climbing Algorithm",
+    .part =
+    {
+        "shortest path",
+        "shortest path"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void* create(void)
+{
+    map_t* map = malloc(sizeof(map_t));
+    if (map != NULL)
+    {
+        grid_init(&map->heightmap);
+        bitset_init(&map->visited);
+    }
+    return map;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    map_t* map = state;
+
+    (void) log;
+
+    if (!parse_input(fp, map))
+    {
+        fprintf(stderr, "Could not read heightmap!\n");
+        return 0;
+    }
+
+    // not recommended to print the large contest grid :-)
+    // print_grid_map(map);
+    // print_grid_visited(map);
+
+    int r = bfs(map);
+    if (r < 0)
+    {
+        fprintf(stderr, "Not enough memory!\n");
+        return 0;
+    }
+
+    solver_answer(result, 1U, "%d", r);
+
+    int shortest = 0;
+    /* search for all position of lowest height and perform bfs */
+    for (size_t y = 0U; y < map->heightmap.height; y++)
+    {
+        for (size_t x = 0U; x < map->heightmap.width; x++)
+        {
+            if (*grid_at(&map->heightmap, (ptrdiff_t) x, (ptrdiff_t) y) == 'a')
+            {
+                map->start.x = x;
+                map->start.y = y;
+                r = bfs(map);
+                if (r < 0)
+                {
+                    fprintf(stderr, "Not enough memory!\n");
+                    return 0;
+                }
+                /* consider only valid results */
+                if ((r > 0) && ((shortest == 0) || (r < shortest)))
+                    shortest = r;
+            }
+        }
+    }
+
+    solver_answer(result, 2U, "%d", shortest);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    map_t* map = state;
+
+    grid_free(&map->heightmap);
+    bitset_free(&map->visited);
+    free(map);
+}
+
+static int parse_input(FILE* fp, map_t* map)
+{
+    assert(fp != NULL);
+    assert(map != NULL);
+
+    /* the border keeps all paths within the map */
+    grid_t* g = &map->heightmap;
+    if (   !grid_read(g, fp, 1U, HEIGHT_BORDER)
+        || !bitset_resize(&map->visited, (g->height + 2U) * g->stride))
+        return 0;
+    map->origin = (ptrdiff_t) g->stride + 1;
+
+    int starts = 0;
+    int ends = 0;
+    for (size_t y = 0U; y < g->height; y++)
+    {
+        for (size_t x = 0U; x < g->width; x++)
+        {
+            char* c = grid_at(g, (ptrdiff_t) x, (ptrdiff_t) y);
+            switch (*c)
+            {
+                case 'S':
+                    map->start.x = x;
+                    map->start.y = y;
+                    *c = 'a';
+                    starts++;
+                    break;
+                case 'E':
+                    map->end.x = x;
+                    map->end.y = y;
+                    *c = 'z';
+                    ends++;
+                    break;
+                default:
+                    if ((*c < 'a') || (*c > 'z'))
+                        return 0;
+                    break;
+            }
+        }
+    }
+
+    /* a single S and E must exist on the grid */
+    return (starts == 1) && (ends == 1);
+}
+
+static void print_grid_map(const map_t* map)
+{
+    assert(map != NULL);
+
+    const grid_t* g = &map->heightmap;
+
+    printf("\nHEIGHTMAP\n");
+    printf("grid size: x = %llu y = %llu\n",
+           (unsigned long long) g->width, (unsigned long long) g->height);
+
+    for (size_t y = 0U; y < g->height; y++)
+    {
+        for (size_t x = 0U; x < g->width; x++)
+            printf("%02d ", *grid_at(g, (ptrdiff_t) x, (ptrdiff_t) y) - 'a');
+        printf("\n");
+    }
+}
+
+static void print_grid_visited(const map_t* map)
+{
+    assert(map != NULL);
+
+    const grid_t* g = &map->heightmap;
+
+    printf("\nVISITED LOCATIONS\n");
+    printf("grid size: x = %llu y = %llu\n",
+           (unsigned long long) g->width, (unsigned long long) g->height);
+
+    for (size_t y = 0U; y < g->height; y++)
+    {
+        for (size_t x = 0U; x < g->width; x++)
+        {
+            if ((x == map->start.x) && (y == map->start.y))
+                printf("S ");
+            else if ((x == map->end.x) && (y == map->end.y))
+                printf("E ");
+            else
+                printf("%d ", bitset_test(&map->visited, (size_t) map->origin + (y * g->stride) + x));
+        }
+        printf("\n");
+    }
+}
+
+/* https://en.wikipedia.org/wiki/Breadth-first_search */
+static int bfs(map_t* map)
+{
+    assert(map != NULL);
+
+    const ptrdiff_t stride = (ptrdiff_t) map->heightmap.stride;
+    const ptrdiff_t steps[4] = {-stride, 1, stride, -1}; /* up, right, down, left */
+    const ptrdiff_t end = (ptrdiff_t) map->end.y * stride + (ptrdiff_t) map->end.x;
+
+    int r;
+    path_t p;
+    p.distance = 0;
+    p.pos = (ptrdiff_t) map->start.y * stride + (ptrdiff_t) map->start.x;
+
+    bitset_clear(&map->visited);
+
+    queue_t* q = queue_init(sizeof(path_t));
+    if (q == NULL)
+        return -1;
+
+    r = queue_enqueue(q, &p) ? 0 : -1;
+    bitset_set(&map->visited, (size_t)(map->origin + p.pos));
+
+    while ((r >= 0) && (0U < queue_count(q)))
+    {
+        r = queue_dequeue(q, &p);
+        assert(r);
+
+        if (p.pos == end)
+        {
+            queue_destroy(q);
+            free(q);
+            return p.distance;
+        }
+
+        for (size_t i = 0U; (i < 4U) && (r >= 0); i++)
+            r = try_move(q, map, &p, steps[i]);
+    }
+
+    queue_destroy(q);
+    free(q);
+    return (r < 0) ? -1 : 0;
+}
+
+static int try_move(queue_t* q, map_t* map, const path_t* p, ptrdiff_t step)
+{
+    path_t next = *p;
+    next.pos += step;
+
+    /*
+     * check if designated path can be entered:
+     * - must not been visited before
+     * - must be at most one higher than current elevation (or any lower),
+     *   which is never true for the border
+     */
+    if (   !bitset_test(&map->visited, (size_t)(map->origin + next.pos))
+        && (map->heightmap.cells[next.pos] <= (map->heightmap.cells[p->pos] + 1)))
+    {
+        next.distance++;
+        if (queue_enqueue(q, &next))
+        {
+            bitset_set(&map->visited, (size_t)(map->origin + next.pos));
+            return 1;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+    else
+    {
+        return 0;
+    }
+}
@@ -0,0 +1,464 @@
+/*
+ * Solver for advent of code 2022 day 14.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day14.h"
+
+#include "grid.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define CHUNK_SIZE    (256U)
+#define SOURCE_X      (500U)
+#define MAX_COORD     (1000000000ULL) /* keeps all sizes far from overflow */
+
+#define CELL(c, x, y) (*grid_at(&(c)->grid, (ptrdiff_t)(x), (ptrdiff_t)(y)))
+
+typedef struct
+{
+    size_t x;
+    size_t y;
+} coords_t;
+
+typedef struct
+{
+    coords_t pos;
+    int first; /* first point of a path */
+} point_t;
+
+typedef struct
+{
+    grid_t grid;
+    coords_t min;
+    coords_t max;
+    size_t source_x; /* column of the sand source */
+} cave_t;
+
+typedef struct
+{
+    cave_t cave_p1;
+    cave_t cave_p2;
+    point_t* points;
+    size_t used;
+    size_t size;
+} state_t;
+
+static void* create(void);
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void destroy(void* state);
+
+static int read_paths(state_t* s, FILE* fp);
+static int read_number(FILE* fp, int* c, unsigned long long* n);
+static int add_point(state_t* s, coords_t pos, int first);
+
+static int grid_create(cave_t* cave, const state_t* s);
+static void grid_insert_ground(cave_t* cave);
+
+static void grid_print(FILE* log, const cave_t* cave);
+
+static void grid_draw_line(cave_t* cave, const coords_t* from, const coords_t* to);
+
+static int grid_drop_sand(cave_t* cave);
+static int grid_move_sand(cave_t* cave);
+
+const solver_t day14_solver =
+{
+    .name = "day14",
+    .title = "Day 14: Regolith Reservoir",
+    .part =
+    {
+        "Amount of sand before it flows into the abyss",
+        "Amount of sand until the source is blocked"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void* create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s != NULL)
+    {
+        grid_init(&s->cave_p1.grid);
+        grid_init(&s->cave_p2.grid);
+        s->points = NULL;
+        s->used = 0U;
+        s->size = 0U;
+    }
+    return s;
+}
+
+static int solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    cave_t* cave_p1 = &s->cave_p1;
+    cave_t* cave_p2 = &s->cave_p2;
+
+    if (!read_paths(s, fp) || !grid_create(cave_p1, s))
+    {
+        fprintf(stderr, "Could not create grid from file!");
+        return 0;
+    }
+
+    /* adjust grid size by creating additional columns left and right and a
+     * row at the bottom -> sand that enters this area falls down and stops the
+     * program
+     */
+    assert(cave_p1->min.x > 0);
+    cave_p1->min.x--;
+    cave_p1->max.x += 2U;
+    cave_p1->max.y += 2U;
+
+    if (!grid_copy(&cave_p2->grid, &cave_p1->grid))
+    {
+        fprintf(stderr, "Not enough memory!");
+        return 0;
+    }
+    cave_p2->min = cave_p1->min;
+    cave_p2->max = cave_p1->max;
+    cave_p2->source_x = cave_p1->source_x;
+    grid_insert_ground(cave_p2);
+
+    int sand_p1 = 0;
+    int running = 1;
+    while (running > 0)
+    {
+        running = grid_drop_sand(cave_p1);
+        if (running >= 0)
+        {
+            sand_p1++;
+            if (running > 0) /* else it fell straight into the abyss */
+                running = grid_move_sand(cave_p1);
+        }
+        else
+        {
+            solver_log(log, "Cannot drop more sand, source blocked!\n");
+        }
+    }
+
+    int sand_p2 = 0;
+    running = 1;
+    while (running > 0)
+    {
+        running = grid_drop_sand(cave_p2);
+        if (running >= 0)
+        {
+            sand_p2++;
+            if (running > 0) /* else it fell straight into the abyss */
+                running = grid_move_sand(cave_p2);
+        }
+        else
+        {
+            solver_log(log, "Cannot drop more sand, source blocked!\n");
+        }
+    }
+
+    solver_log(log, "Final grid of part 1:\n");
+    grid_print(log, cave_p1);
+    // grid_print(log, cave_p2); /* I recommend to redirect this to a file */
+    assert(sand_p1 > 0);
+    solver_answer(result, 1U, "%d", sand_p1 - 1);
+    solver_answer(result, 2U, "%d", sand_p2);
+
+    return 1;
+}
+
+static void destroy(void* state)
+{
+    state_t* s = state;
+
+    grid_free(&s->cave_p1.grid);
+    grid_free(&s->cave_p2.grid);
+    free(s->points);
+    free(s);
+}
+
+static int read_paths(state_t* s, FILE* fp)
+{
+    s->used = 0U;
+
+    /* lines are parsed while reading, so they can have any length */
+    int first = 1;
+    int c = fgetc(fp);
+    while (c != EOF)
+    {
+        if ((c == '\n') || (c == '\r')) /* next path */
+        {
+            first = 1;
+            c = fgetc(fp);
+            continue;
+        }
+
+        unsigned long long x;
+        unsigned long long y;
+        if (!read_number(fp, &c, &x) || (c != ','))
+            return 0;
+        c = fgetc(fp);
+        if (!read_number(fp, &c, &y))
+            return 0;
+        coords_t pos = {.x = (size_t) x, .y = (size_t) y};
+        /* rock is only drawn by vertical or horizontal lines */
+        if (   !first
+            && (pos.x != s->points[s->used - 1U].pos.x)
+            && (pos.y != s->points[s->used - 1U].pos.y))
+            return 0;
+        if (!add_point(s, pos, first))
+            return 0;
+        first = 0;
+
+        if (c == ' ') /* " -> " */
+        {
+            if ((fgetc(fp) != '-') || (fgetc(fp) != '>') || (fgetc(fp) != ' '))
+                return 0;
+            c = fgetc(fp);
+        }
+        else if ((c != '\n') && (c != '\r') && (c != EOF))
+        {
+            return 0;
+        }
+    }
+
+    return s->used > 0U;
+}
+
+static int read_number(FILE* fp, int* c, unsigned long long* n)
+{
+    if ((*c < '0') || (*c > '9'))
+        return 0;
+
+    *n = 0U;
+    while ((*c >= '0') && (*c <= '9'))
+    {
+        *n = (*n * 10U) + (unsigned long long) (*c - '0');
+        if (*n > MAX_COORD)
+            return 0;
+        *c = fgetc(fp);
+    }
+
+    return 1;
+}
+
+static int add_point(state_t* s, coords_t pos, int first)
+{
+    if (s->used >= s->size)
+    {
+        size_t size = s->size + CHUNK_SIZE;
+        point_t* points = realloc(s->points, size * sizeof(point_t));
+        if (points == NULL)
+            return 0;
+        s->points = points;
+        s->size = size;
+    }
+
+    s->points[s->used].pos = pos;
+    s->points[s->used].first = first;
+    s->used++;
+
+    return 1;
+}
+
+static int grid_create(cave_t* cave, const state_t* s)
+{
+    coords_t lo = s->points[0].pos;
+    coords_t hi = s->points[0].pos;
+    for (size_t i = 1U; i < s->used; i++)
+    {
+        if (s->points[i].pos.x < lo.x)
+            lo.x = s->points[i].pos.x;
+        if (s->points[i].pos.x > hi.x)
+            hi.x = s->points[i].pos.x;
+        if (s->points[i].pos.y > hi.y)
+            hi.y = s->points[i].pos.y;
+    }
+
+    /* sand piles up to the floor two rows below the lowest rock, at most as
+     * wide as high on both sides of the source (part 2), column 0 is the
+     * input column left, which is negative for a deep cave
+     */
+    ptrdiff_t margin = (ptrdiff_t) hi.y + 3;
+    ptrdiff_t left = (ptrdiff_t) SOURCE_X - margin;
+    if (((ptrdiff_t) lo.x - 1) < left)
+        left = (ptrdiff_t) lo.x - 1;
+    ptrdiff_t right = (ptrdiff_t) SOURCE_X + margin;
+    if (((ptrdiff_t) hi.x + 1) > right)
+        right = (ptrdiff_t) hi.x + 1;
+    if (!grid_resize(&cave->grid, (size_t) (right - left + 1), hi.y + 3U, 0U, '.'))
+        return 0;
+
+    cave->source_x = (size_t) ((ptrdiff_t) SOURCE_X - left);
+    cave->min.x = (size_t) ((ptrdiff_t) lo.x - left);
+    cave->min.y = 0U;
+    cave->max.x = (size_t) ((ptrdiff_t) hi.x - left);
+    cave->max.y = hi.y;
+    CELL(cave, cave->source_x, 0) = '+';
+
+    for (size_t i = 1U; i < s->used; i++)
+    {
+        if (!s->points[i].first)
+        {
+            coords_t from = {(size_t) ((ptrdiff_t) s->points[i - 1U].pos.x - left), s->points[i - 1U].pos.y};
+            coords_t to = {(size_t) ((ptrdiff_t) s->points[i].pos.x - left), s->points[i].pos.y};
+            grid_draw_line(cave, &from, &to);
+        }
+    }
+
+    return 1;
+}
+
+static void grid_insert_ground(cave_t* cave)
+{
+    assert((cave->max.y + 1U) == cave->grid.height);
+    cave->min.x = 0U;
+    cave->max.x = cave->grid.width;
+    for (size_t x = 0U; x < cave->max.x; x++)
+    {
+        CELL(cave, x, cave->max.y) = '#';
+    }
+    cave->max.y++;
+}
+
+static void grid_print(FILE* log, const cave_t* cave)
+{
+    if (log == NULL)
+        return;
+
+    assert((cave->max.x - cave->min.x) >= 6U); /* min length for x axis legend */
+
+    /* legend shows the x coordinates of the input */
+    ptrdiff_t offset = (ptrdiff_t) SOURCE_X - (ptrdiff_t) cave->source_x;
+    solver_log(log, "    %03lld", (long long) ((ptrdiff_t) cave->min.x + offset));
+    for (size_t n = 0U; n < (cave->max.x - cave->min.x - 6U); n++ )
+        solver_log(log, " ");
+    solver_log(log, "%03lld\n", (long long) ((ptrdiff_t) cave->max.x + offset - 1));
+    for (size_t y = cave->min.y; y < cave->max.y; y++)
+    {
+        if ((y == cave->min.y) || ((y + 1U) >= cave->max.y))
+            solver_log(log, "%03llu ", (unsigned long long) y);
+        else
+            solver_log(log, "    ");
+        for (size_t x = cave->min.x; x < cave->max.x; x++)
+            solver_log(log, "%c", CELL(cave, x, y));
+        solver_log(log, "\n");
+    }
+}
+
+static void grid_draw_line(cave_t* cave, const coords_t* from, const coords_t* to)
+{
+    if (from->x == to->x) /* vertical line */
+    {
+        if (from->y <= to->y) /* draw down */
+            for (size_t y = from->y; y <= to->y; y++)
+                CELL(cave, from->x, y) = '#';
+        else /* draw up */
+            for (size_t y = to->y; y <= from->y; y++)
+                CELL(cave, from->x, y) = '#';
+    }
+    else if (from->y == to->y) /* horizontal line */
+    {
+        if (from->x <= to->x) /* draw right */
+            for (size_t x = from->x; x <= to->x; x++)
+                CELL(cave, x, from->y) = '#';
+        else /* draw left */
+            for (size_t x = to->x; x <= from->x; x++)
+                CELL(cave, x, from->y) = '#';
+    }
+    else
+        assert(0); /* not a vertical or horizontal line */
+}
+
+static int grid_drop_sand(cave_t* cave)
+{
+    if (CELL(cave, cave->source_x, 0) == 'o')
+    {
+        return -1; /* source blocked */
+    }
+    else
+    {
+        for (size_t y = 1U; y < cave->max.y; y++)
+        {
+            if (   (CELL(cave, cave->source_x, y) == '#')
+                || (CELL(cave, cave->source_x, y) == 'o'))
+            {
+                CELL(cave, cave->source_x, y - 1U) = 'o';
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int grid_move_sand(cave_t* cave)
+{
+    int sand_moving = 1;
+    while (sand_moving) /* could result in an infinite loop if there is a bug or false input :-) */
+    {
+        sand_moving = 0;
+        for (size_t y = cave->min.y; y < cave->max.y; y++)
+        {
+            for (size_t x = cave->min.x; x < cave->max.x; x++)
+            {
+                /* looking for sand */
+                if (CELL(cave, x, y) == 'o')
+                {
+                    /* check if space below sand is free (highest priority)*/
+                    if ((CELL(cave, x, y + 1U) == '.'))
+                    {
+                        /* scan the column below */
+                        for (size_t yy = (y + 1U); yy < cave->max.y; yy++)
+                        {
+                            if (CELL(cave, x, yy) == '.')
+                            {
+                                /* free, check if this is the very last row */
+                                if ((yy + 1U) >= (cave->max.y))
+                                {
+                                    /* sand will fall into abyss*/
+                                    return 0;
+                                }
+                                /* else look further down */
+                            }
+                            else
+                            {
+                                /* reach an obstacle, drop the sand on top */
+                                CELL(cave, x, y) = '.';
+                                CELL(cave, x, yy - 1U) = 'o';
+                                sand_moving = 1;
+                                break;
+                            }
+                        }
+                    }
+                    /* check if the space diagonal down left is free (2nd
+                     * highest priority)
+                     */
+                    else if ((x > 0) && (CELL(cave, x - 1U, y + 1U) == '.'))
+                    {
+                        CELL(cave, x, y) = '.';
+                        CELL(cave, x - 1U, y + 1U) = 'o';
+                        sand_moving = 1;
+                    }
+                    /* check if the space diagonal down right is free (lowest
+                     * priority)
+                     */
+                    else if (((x + 1U) < cave->max.x) && (CELL(cave, x + 1U, y + 1U) == '.'))
+                    {
+                        CELL(cave, x, y) = '.';
+                        CELL(cave, x + 1U, y + 1U) = 'o';
+                        sand_moving = 1;
+                    }
+                }
+            }
+        }
+    }
+
+    return 1;
+}
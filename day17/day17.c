@@ -0,0 +1,373 @@
+/*
+ * Solver for advent of code 2022 day 17.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day17.h"
+
+#include "bitset.h"
+#include "rocks.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define CHUNK_SIZE (128U)
+#define NUM_ROCKS  (2022U)
+#define CAVE_WIDTH (7U)
+
+typedef struct
+{
+    char *data;
+    size_t used;
+    size_t size;
+} jet_pattern_t;
+
+typedef struct
+{
+    bitmatrix_t rows; /* row 0 is the floor, bit 0 of a row is left */
+    size_t used;      /* number of rows up to the highest rock */
+} chamber_t;
+
+typedef struct
+{
+    size_t x;
+    size_t y;
+} coords_t;
+
+typedef struct
+{
+    const rock_t* rock;
+    coords_t pos;
+} object_t;
+
+typedef struct
+{
+    jet_pattern_t jp;
+    chamber_t chamber;
+} state_t;
+
+static void*
+create(void);
+
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+
+static void
+destroy(void* state);
+
+/* initialize/prepare chamber once */
+static int
+chamber_init(chamber_t* c);
+
+/* clear chamber for reuse, keeps allocated memory */
+static void
+chamber_reset(chamber_t* c);
+
+/* extend height of chamber if necessary */
+static int
+chamber_extend(chamber_t* c, size_t h);
+
+/* print current status of chamber */
+static void
+chamber_print(FILE* log, const chamber_t* c);
+
+/* add a landed rock to chamber grid */
+static int
+chamber_add_rock(chamber_t* c, const object_t* r);
+
+/* spawn the n-th rock that will start falling down */
+static int
+chamber_spawn_rock(chamber_t* c, object_t* o, size_t n);
+
+/* check for collision at given position*/
+static int
+check_collision(const chamber_t* c, const rock_t* r, size_t r_x, size_t r_y);
+
+/* delete chamber object, cleanup memory */
+static void
+chamber_delete(chamber_t* c);
+
+const solver_t day17_solver =
+{
+    .name = "day17",
+    .title = "Day 17: Pyroclastic Flow",
+    .part =
+    {
+        "height of rocks",
+        "height of rocks"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void*
+create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->jp.size = CHUNK_SIZE;
+    s->jp.data = (char*) malloc(s->jp.size * sizeof(char));
+    if (s->jp.data == NULL)
+    {
+        free(s);
+        return NULL;
+    }
+
+    if (chamber_init(&s->chamber) < 0)
+    {
+        free(s->jp.data);
+        free(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+    jet_pattern_t* jp = &s->jp;
+    chamber_t* chamber = &s->chamber;
+
+    jp->used = 0U;
+
+    int c;
+    while ((c = fgetc(fp)) != EOF)
+    {
+        if ((c == '\n') || (c == '\r'))
+            continue;
+        if ((c != '<') && (c != '>'))
+        {
+            fprintf(stderr, "Invalid jet '%c' in pattern.", c);
+            return 0;
+        }
+        if (jp->used >= jp->size)
+        {
+            char* data = (char*) realloc(jp->data, (jp->size + CHUNK_SIZE) * sizeof(char));
+            if (data == NULL)
+            {
+                fprintf(stderr, "Not enough memory!");
+                return 0;
+            }
+            jp->data = data;
+            jp->size += CHUNK_SIZE;
+        }
+
+        jp->data[jp->used] = (char) c;
+        jp->used++;
+    }
+
+    if (jp->used == 0U)
+    {
+        fprintf(stderr, "No jet pattern found.");
+        return 0;
+    }
+
+    chamber_reset(chamber);
+
+    size_t jet = 0U;
+    for (size_t rocks = 0U; rocks < NUM_ROCKS; rocks++)
+    {
+        object_t object;
+
+        if (chamber_spawn_rock(chamber, &object, rocks) < 0)
+        {
+            fprintf(stderr, "Failed to spawn new rock.");
+            return 0;
+        }
+
+        // solver_log(log, "rock #%llu\n", rocks);
+
+        int moving = 1;
+        size_t alternate = 0U; /* alternate between gravity and jet streams */
+        while (moving > 0)
+        {
+            moving = 0;
+            if ((alternate % 2U) == 0U) /* pushed by jet */
+            {
+                if (jp->data[jet % jp->used] == '>') /* push right */
+                {
+                    if ((object.pos.x + object.rock->width) < CAVE_WIDTH)
+                    {
+                        if (!check_collision(chamber, object.rock, object.pos.x + 1, object.pos.y))
+                        {
+                            object.pos.x++;
+                        }
+                    }
+                }
+                else
+                {
+                    assert(jp->data[jet % jp->used] == '<'); /* push left */
+                    if (object.pos.x > 0U)
+                    {
+                        if (!check_collision(chamber, object.rock, object.pos.x - 1, object.pos.y))
+                        {
+                            object.pos.x--;
+                        }
+                    }
+                }
+                jet++;
+                moving = 1;
+            }
+            else /* fall down */
+            {
+                if ((object.pos.y - object.rock->height) > 0U)
+                {
+                    if (!check_collision(chamber, object.rock, object.pos.x, object.pos.y - 1))
+                    {
+                        object.pos.y--;
+                        moving = 1;
+                    }
+                }
+            }
+            alternate++;
+        }
+        chamber_add_rock(chamber, &object);
+
+        // chamber_print(log, chamber);
+        // solver_log(log, "\n");
+    }
+
+    (void) log;
+
+    /* minus floor */
+    solver_answer(result, 1U, "%llu", (unsigned long long) chamber->used - 1U);
+
+    return 1;
+}
+
+static void
+destroy(void* state)
+{
+    state_t* s = state;
+
+    chamber_delete(&s->chamber);
+    free(s->jp.data);
+    free(s);
+}
+
+static int
+chamber_init(chamber_t* c)
+{
+    assert(c != NULL);
+
+    bitmatrix_init(&c->rows);
+    c->used = 0U;
+
+    return chamber_extend(c, 1U);
+}
+
+static void
+chamber_reset(chamber_t* c)
+{
+    assert(c != NULL);
+
+    bitset_clear(&c->rows.bits);
+
+    /* restore floor pattern */
+    *bitmatrix_row(&c->rows, 0U, 0U) = ((uint64_t) 1U << CAVE_WIDTH) - 1U;
+    c->used = 1U;
+}
+
+static int
+chamber_extend(chamber_t* c, size_t h)
+{
+    assert(c != NULL);
+    assert(h > 0U);
+
+    if ((c->rows.height - c->used) >= (h + 3U))
+        return 0;
+
+    /* rows above the used ones are empty, they are kept on resizing */
+    if (!bitmatrix_resize(&c->rows, CAVE_WIDTH, c->used + h + 3U, 1U))
+        return -1;
+
+    return 1;
+}
+
+static void
+chamber_print(FILE* log, const chamber_t* c)
+{
+    assert(c != NULL);
+
+    for (size_t y = c->rows.height; y-- > 0U; )
+    {
+        uint64_t row = *bitmatrix_row(&c->rows, y, 0U);
+        for (size_t x = 0U; x < CAVE_WIDTH; x++)
+        {
+            if (y == 0U)
+                solver_log(log, "-");
+            else
+                solver_log(log, "%c", ((row >> x) & 1U) ? '#' : '.');
+        }
+        solver_log(log, "\n");
+    }
+}
+
+static int
+chamber_add_rock(chamber_t* c, const object_t* r)
+{
+    assert(c != NULL);
+    assert(r->pos.y >= r->rock->height);
+
+    /* row k of the rock is the k-th row below its top */
+    for (size_t k = 0U; k < r->rock->height; k++)
+    {
+        *bitmatrix_row(&c->rows, r->pos.y - k, 0U) |= (uint64_t) r->rock->mask[k] << r->pos.x;
+    }
+
+    if ( r->pos.y >= c->used)
+        c->used += r->pos.y - c->used + 1U;
+
+    return 1;
+}
+
+static int
+chamber_spawn_rock(chamber_t* c, object_t* o, size_t n)
+{
+    assert(c != NULL);
+
+    o->rock = rock_get(n);
+
+    if (chamber_extend(c, o->rock->height) < 0)
+        return -1;
+
+    o->pos.x = 2U;
+    o->pos.y = c->used + 3U + o->rock->height - 1U;
+
+    return 1;
+}
+
+static int
+check_collision(const chamber_t* c, const rock_t* r, size_t r_x, size_t r_y)
+{
+    assert(r_y >= r->height);
+    assert(r_y < c->rows.height);
+
+    /* a whole row of the rock at once */
+    for (size_t k = 0U; k < r->height; k++)
+    {
+        if (*bitmatrix_row(&c->rows, r_y - k, 0U) & ((uint64_t) r->mask[k] << r_x))
+            return 1;
+    }
+
+    return 0;
+}
+
+static void
+chamber_delete(chamber_t* c)
+{
+    bitmatrix_free(&c->rows);
+    c->used = 0U;
+}
@@ -11,7 +11,7 @@
 
 #include <stdio.h>
 
-const rock_t rocks[] =
+static const rock_t rocks[] =
 {
     {
         .fig = {
@@ -20,6 +20,7 @@ const rock_t rocks[] =
                     {'.', '.', '.', '.'},
                     {'.', '.', '.', '.'},
                 },
+        .mask = {0x0FU, 0x00U, 0x00U, 0x00U},
         .width = 4,
         .height = 1
     },
@@ -30,6 +31,7 @@ const rock_t rocks[] =
                     {'.', '@', '.', '.'},
                     {'.', '.', '.', '.'},
                 },
+        .mask = {0x02U, 0x07U, 0x02U, 0x00U},
         .width = 3,
         .height = 3
     },
@@ -40,6 +42,7 @@ const rock_t rocks[] =
                     {'@', '@', '@', '.'},
                     {'.', '.', '.', '.'},
                 },
+        .mask = {0x04U, 0x04U, 0x07U, 0x00U},
         .width = 3,
         .height = 3
     },
@@ -50,6 +53,7 @@ const rock_t rocks[] =
                     {'@', '.', '.', '.'},
                     {'@', '.', '.', '.'},
                 },
+        .mask = {0x01U, 0x01U, 0x01U, 0x01U},
         .width = 1,
         .height = 4
     },
@@ -60,20 +64,16 @@ const rock_t rocks[] =
                     {'.', '.', '.', '.'},
                     {'.', '.', '.', '.'},
                 },
+        .mask = {0x03U, 0x03U, 0x00U, 0x00U},
         .width = 2,
         .height = 2
     }
 };
 
 const rock_t*
-rock_get()
+rock_get(size_t n)
 {
-    static size_t count = 0U;
-
-    if (count >= (sizeof(rocks) / sizeof(rock_t)))
-        count = 0U;
-
-    return &rocks[count++];
+    return &rocks[n % (sizeof(rocks) / sizeof(rock_t))];
 }
 
 void
@@ -10,6 +10,7 @@
 #ifndef ROCK_H_
 #define ROCK_H_
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #define ROCK_WIDTH_MAX  (4)
@@ -18,13 +19,14 @@
 typedef struct
 {
     char fig[ROCK_HEIGHT_MAX][ROCK_WIDTH_MAX];
+    uint8_t mask[ROCK_HEIGHT_MAX]; /* rows of fig as bits, bit 0 is left */
     size_t width;
     size_t height;
 } rock_t;
 
-/* get (next) rock, loops through all types */
+/* get n-th rock, loops through all types */
 const rock_t*
-rock_get();
+rock_get(size_t n);
 
 void
 rock_print(const rock_t* r);
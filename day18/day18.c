@@ -0,0 +1,276 @@
+/*
+ * Solver for advent of code 2022 day 18.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day18.h"
+
+#include "bitset.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define CHUNK_SIZE (128U)
+#define NUM_DIRS   (6U)
+
+typedef struct
+{
+    int x;
+    int y;
+    int z;
+} cube_t;
+
+typedef struct
+{
+    cube_t* cubes;
+    size_t used;
+    size_t size;
+    bitmatrix_t droplet;  /* one bit per cube, empty border around */
+    bitset_t air;         /* all cells of the matrix without cubes and padding */
+    bitset_t outside;     /* air reachable from the border */
+    bitset_t grown;
+    bitset_t tmp;
+} state_t;
+
+static void*
+create(void);
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void
+destroy(void* state);
+
+static int
+read_cubes(state_t* s, FILE* fp);
+static int
+build_droplet(state_t* s);
+static void
+shift(bitset_t* dst, const bitset_t* src, const bitmatrix_t* m, size_t dir);
+static size_t
+count_faces(state_t* s, const bitset_t* neighbours, int exposed);
+static void
+flood_outside(state_t* s);
+
+const solver_t day18_solver =
+{
+    .name = "day18",
+    .title = "Day 18: Boiling Boulders",
+    .part =
+    {
+        "surface area",
+        "exterior surface area"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void*
+create(void)
+{
+    state_t* s = malloc(sizeof(state_t));
+    if (s == NULL)
+        return NULL;
+
+    s->cubes = NULL;
+    s->used = 0U;
+    s->size = 0U;
+    bitmatrix_init(&s->droplet);
+    bitset_init(&s->air);
+    bitset_init(&s->outside);
+    bitset_init(&s->grown);
+    bitset_init(&s->tmp);
+
+    return s;
+}
+
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    state_t* s = state;
+
+    (void) log;
+
+    if (!read_cubes(s, fp) || !build_droplet(s))
+    {
+        fprintf(stderr, "Could not read cubes!\n");
+        return 0;
+    }
+
+    /* faces of cubes without a cube next to them */
+    size_t area = count_faces(s, &s->droplet.bits, 1);
+    solver_answer(result, 1U, "%llu", (unsigned long long) area);
+
+    /* faces of cubes with outside air next to them */
+    flood_outside(s);
+    size_t exterior = count_faces(s, &s->outside, 0);
+    solver_answer(result, 2U, "%llu", (unsigned long long) exterior);
+
+    return 1;
+}
+
+static void
+destroy(void* state)
+{
+    state_t* s = state;
+
+    free(s->cubes);
+    bitmatrix_free(&s->droplet);
+    bitset_free(&s->air);
+    bitset_free(&s->outside);
+    bitset_free(&s->grown);
+    bitset_free(&s->tmp);
+    free(s);
+}
+
+static int
+read_cubes(state_t* s, FILE* fp)
+{
+    s->used = 0U;
+
+    char line_buf[CHUNK_SIZE];
+    while (fgets(line_buf, CHUNK_SIZE, fp))
+    {
+        cube_t cube;
+        if (sscanf(line_buf, "%d,%d,%d", &cube.x, &cube.y, &cube.z) != 3)
+            return 0;
+
+        if (s->used >= s->size)
+        {
+            size_t size = s->size + CHUNK_SIZE;
+            cube_t* cubes = realloc(s->cubes, size * sizeof(cube_t));
+            if (cubes == NULL)
+                return 0;
+            s->cubes = cubes;
+            s->size = size;
+        }
+        s->cubes[s->used++] = cube;
+    }
+
+    return s->used > 0U;
+}
+
+static int
+build_droplet(state_t* s)
+{
+    cube_t min = s->cubes[0];
+    cube_t max = s->cubes[0];
+    for (size_t i = 1U; i < s->used; i++)
+    {
+        const cube_t* c = &s->cubes[i];
+        min.x = (c->x < min.x) ? c->x : min.x;
+        min.y = (c->y < min.y) ? c->y : min.y;
+        min.z = (c->z < min.z) ? c->z : min.z;
+        max.x = (c->x > max.x) ? c->x : max.x;
+        max.y = (c->y > max.y) ? c->y : max.y;
+        max.z = (c->z > max.z) ? c->z : max.z;
+    }
+
+    /* an empty layer on each side connects the air around the droplet and
+     * keeps the shifted bits of the border away from the cubes
+     */
+    if (   ((max.x - min.x) > (INT_MAX - 3))
+        || ((max.y - min.y) > (INT_MAX - 3))
+        || ((max.z - min.z) > (INT_MAX - 3)))
+        return 0;
+    bitmatrix_t* m = &s->droplet;
+    if (!bitmatrix_resize(m,
+                          (size_t)(max.x - min.x) + 3U,
+                          (size_t)(max.y - min.y) + 3U,
+                          (size_t)(max.z - min.z) + 3U))
+        return 0;
+
+    size_t bits = m->bits.bits;
+    if (   !bitset_resize(&s->air, bits)
+        || !bitset_resize(&s->outside, bits)
+        || !bitset_resize(&s->grown, bits)
+        || !bitset_resize(&s->tmp, bits))
+        return 0;
+
+    for (size_t i = 0U; i < s->used; i++)
+    {
+        const cube_t* c = &s->cubes[i];
+        bitset_set(&m->bits,
+                   bitmatrix_index(m,
+                                   (size_t)(c->x - min.x) + 1U,
+                                   (size_t)(c->y - min.y) + 1U,
+                                   (size_t)(c->z - min.z) + 1U));
+    }
+
+    /* mark all cells within the width of each row, except the cubes */
+    bitset_clear(&s->air);
+    for (size_t i = 0U; i < (m->height * m->depth); i++)
+    {
+        size_t row = i * m->row_words * BITSET_WORD_BITS;
+        for (size_t x = 0U; x < m->width; x++)
+            bitset_set(&s->air, row + x);
+    }
+    bitset_andnot(&s->air, &s->air, &m->bits);
+
+    return 1;
+}
+
+/* move each bit to its neighbour in given direction: -x, +x, -y, +y, -z, +z */
+static void
+shift(bitset_t* dst, const bitset_t* src, const bitmatrix_t* m, size_t dir)
+{
+    size_t row = m->row_words * BITSET_WORD_BITS;
+    const size_t distance[3] = {1U, row, row * m->height};
+
+    if ((dir % 2U) == 0U)
+        bitset_shift_up(dst, src, distance[dir / 2U]);
+    else
+        bitset_shift_down(dst, src, distance[dir / 2U]);
+}
+
+/* count faces of cubes whose neighbour is (not) set */
+static size_t
+count_faces(state_t* s, const bitset_t* neighbours, int exposed)
+{
+    const bitset_t* cubes = &s->droplet.bits;
+    size_t n = 0U;
+
+    for (size_t d = 0U; d < NUM_DIRS; d++)
+    {
+        shift(&s->tmp, neighbours, &s->droplet, d);
+        if (exposed)
+            bitset_andnot(&s->tmp, cubes, &s->tmp);
+        else
+            bitset_and(&s->tmp, cubes, &s->tmp);
+        n += bitset_count(&s->tmp);
+    }
+
+    return n;
+}
+
+/* grow the outside air from a corner, all cells of a step at once */
+static void
+flood_outside(state_t* s)
+{
+    bitset_clear(&s->outside);
+    bitset_set(&s->outside, 0U);
+
+    size_t count = 1U;
+    for (;;)
+    {
+        bitset_copy(&s->grown, &s->outside);
+        for (size_t d = 0U; d < NUM_DIRS; d++)
+        {
+            shift(&s->tmp, &s->outside, &s->droplet, d);
+            bitset_or(&s->grown, &s->grown, &s->tmp);
+        }
+        bitset_and(&s->outside, &s->grown, &s->air);
+
+        size_t c = bitset_count(&s->outside);
+        if (c == count)
+            break;
+        count = c;
+    }
+}
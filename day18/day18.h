@@ -0,0 +1,17 @@
+/*
+ * Solver for advent of code 2022 day 18.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY18_H_
+#define DAY18_H_
+
+#include "solver.h"
+
+extern const solver_t day18_solver;
+
+#endif /* DAY18_H_ */
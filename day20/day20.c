@@ -0,0 +1,272 @@
+/*
+ * Solver for advent of code 2022 day 20.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day20.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define CHUNK_SIZE (128U)
+
+typedef struct
+{
+    size_t idx;
+    int num;
+} data_t;
+
+typedef struct node
+{
+    data_t data;
+    struct node* prev;
+    struct node* next;
+} node_t;
+
+static int
+list_add_tail(node_t** node, data_t* data);
+
+static node_t*
+list_find_idx(node_t* node, size_t idx);
+
+static node_t*
+list_find_num(node_t* node, int num);
+
+static node_t*
+list_get_node(node_t* node, size_t n);
+
+static int
+list_move_node(node_t** node, size_t idx);
+
+static void
+list_free(node_t** node);
+
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+
+const solver_t day20_solver =
+{
+    .name = "day20",
+    .title = "Day 20: Grove Positioning System",
+    .part =
+    {
+        "sum of grove coordinates",
+        "sum of grove coordinates"
+    },
+    .create = NULL,
+    .solve = solve,
+    .destroy = NULL
+};
+
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    (void) state;
+    (void) log;
+
+    node_t* head = NULL;
+
+    char line_buf[CHUNK_SIZE];
+    data_t data = {0};
+    size_t n = 0U;
+    while (fgets(line_buf, CHUNK_SIZE, fp))
+    {
+        if (sscanf(line_buf, "%d", &data.num) == 1)
+        {
+            if (!list_add_tail(&head, &data))
+            {
+                fprintf(stderr, "Not enough memory!");
+                list_free(&head);
+                return 0;
+            }
+            n++;
+            data.idx++;
+        }
+        else if (line_buf[strspn(line_buf, " \r\n")] != '\0')
+        {
+            fprintf(stderr, "Invalid number: %s", line_buf);
+            list_free(&head);
+            return 0;
+        }
+    }
+
+    for (size_t i = 0U; i < n; i++)
+    {
+        int r = list_move_node(&head, i);
+        assert(r > 0);
+    }
+
+    int sum = 0;
+    for (size_t offset = 1000U; offset <= 3000U; offset += 1000U)
+    {
+        node_t* node = list_get_node(head, offset);
+        if (node == NULL)
+        {
+            fprintf(stderr, "No number 0 in file!");
+            list_free(&head);
+            return 0;
+        }
+        sum += node->data.num;
+    }
+
+    solver_answer(result, 1U, "%d", sum);
+    // -258 is wrong
+
+    list_free(&head);
+
+    return 1;
+}
+
+static int
+list_add_tail(node_t** node, data_t* data)
+{
+    node_t* new_node = (node_t*)malloc(sizeof(node_t));
+    if (new_node == NULL)
+        return 0;
+
+    new_node->data = *data;
+
+    if (*node == NULL)
+    {
+        new_node->prev = new_node;
+        new_node->next = new_node;
+        *node = new_node;
+    }
+    else
+    {
+        new_node->prev = (*node)->prev;
+        new_node->next = *node;
+        (*node)->prev->next = new_node;
+        (*node)->prev = new_node;
+    }
+
+    return 1;
+}
+
+static node_t*
+list_find_idx(node_t* node, size_t idx)
+{
+    if (node == NULL)
+        return NULL;
+
+    node_t* tmp = node;
+    do
+    {
+        if (tmp->data.idx == idx)
+            return tmp;
+        tmp = tmp->next;
+    }
+    while(tmp != node);
+
+    return NULL;
+}
+
+static node_t*
+list_find_num(node_t* node, int num)
+{
+    if (node == NULL)
+        return NULL;
+
+    node_t* tmp = node;
+    do
+    {
+        if (tmp->data.num == num)
+            return tmp;
+        tmp = tmp->next;
+    }
+    while(tmp != node);
+
+    return NULL;
+}
+
+static node_t*
+list_get_node(node_t* node, size_t n)
+{
+    if (node == NULL)
+        return NULL;
+
+    node_t* tmp = list_find_num(node, 0);
+    if (tmp == NULL)
+        return NULL;
+    while (n > 0U)
+    {
+        tmp = tmp->next;
+        n--;
+    }
+
+    return tmp;
+}
+
+static int
+list_move_node(node_t** node, size_t idx)
+{
+    assert(*node != NULL);
+
+    node_t* tmp = list_find_idx(*node, idx);
+    if (tmp == NULL)
+        return 0;
+    int steps = tmp->data.num;
+    node_t* repl = tmp;
+
+    if (steps > 0)
+    {
+        /* move tmp after repl */
+        while (steps > 0)
+        {
+            repl = repl->next;
+            steps--;
+        }
+        if (repl == tmp) //TODO handle this case
+            return 1;
+        tmp->prev->next = tmp->next;
+        tmp->next->prev = tmp->prev;
+        repl->next->prev = tmp;
+        tmp->next = repl->next;
+        repl->next = tmp;
+        tmp->prev = repl;
+    }
+    else if (steps < 0)
+    {
+        /* move tmp before repl */
+        while (steps < 0)
+        {
+            repl = repl->prev;
+            steps++;
+        }
+        if (repl == tmp) //TODO handle this case
+            return 1;
+        tmp->prev->next = tmp->next;
+        tmp->next->prev = tmp->prev;
+        repl->prev->next = tmp;
+        tmp->prev = repl->prev;
+        repl->prev = tmp;
+        tmp->next = repl;
+    }
+
+    return 1;
+}
+
+static void
+list_free(node_t** head)
+{
+    if (*head == NULL)
+        return;
+
+    node_t* tmp = *head;
+    do
+    {
+        node_t* next = tmp->next;
+        free(tmp);
+        tmp = next;
+    }
+    while (tmp != *head);
+
+    *head = NULL;
+}
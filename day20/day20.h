@@ -0,0 +1,17 @@
+/*
+ * Solver for advent of code 2022 day 20.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY20_H_
+#define DAY20_H_
+
+#include "solver.h"
+
+extern const solver_t day20_solver;
+
+#endif /* DAY20_H_ */
@@ -0,0 +1,231 @@
+/*
+ * Solver for advent of code 2022 day 21.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day21.h"
+
+#include "hashtable.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#define CHUNK_SIZE (128U)
+
+typedef enum
+{
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_EQUAL,
+    OP_NONE
+} opsel_t;
+
+typedef struct
+{
+    char id[5];
+    char op_l[5];
+    char op_r[5];
+    char op_raw;
+    opsel_t op;
+    uint64_t num;
+} data_t;
+
+static int
+add_monkey(data_t** monkeys, size_t* used, size_t* size, const data_t* data);
+
+static int
+add_to_hashtab(hashtable_t* ht, data_t* data);
+
+static int
+calc(hashtable_t* ht, const char* key, size_t depth, uint64_t* number);
+
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+
+const solver_t day21_solver =
+{
+    .name = "day21",
+    .title = "Day 21: Monkey Math",
+    .part =
+    {
+        "number",
+        "number"
+    },
+    .create = NULL,
+    .solve = solve,
+    .destroy = NULL
+};
+
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    (void) state;
+
+    hashtable_t* ht = ht_init(100U);
+    data_t* monkeys = NULL;
+    size_t used = 0U;
+    size_t size = 0U;
+
+    if (ht == NULL)
+    {
+        fprintf(stderr, "Not enough memory!");
+        return 0;
+    }
+
+    int ok = 1;
+    char line_buf[CHUNK_SIZE];
+    while (ok && fgets(line_buf, CHUNK_SIZE, fp))
+    {
+        data_t data = {0};
+        if (line_buf[strspn(line_buf, " \r\n")] == '\0')
+            continue; /* empty line */
+        if (sscanf( line_buf,
+                    "%4s: %4s %c %4s",
+                    data.id,
+                    data.op_l,
+                    &data.op_raw,
+                    data.op_r) == 4)
+        {
+            switch(data.op_raw)
+            {
+                case '+':
+                    data.op = OP_ADD;
+                    break;
+                case '-':
+                    data.op = OP_SUB;
+                    break;
+                case '*':
+                    data.op = OP_MUL;
+                    break;
+                case '/':
+                    data.op = OP_DIV;
+                    break;
+                default:
+                    ok = 0;
+            }
+        }
+        else if (sscanf(line_buf,
+                        "%4s: %llu",
+                        data.id,
+                        &data.num) == 2)
+        {
+            data.op = OP_NONE;
+        }
+        else
+        {
+            ok = 0;
+        }
+        if (!ok)
+            fprintf(stderr, "Invalid monkey: %s", line_buf);
+        else if (!(ok = add_monkey(&monkeys, &used, &size, &data)))
+            fprintf(stderr, "Not enough memory!");
+    }
+
+    /* the table points into the array of monkeys, it does not move anymore */
+    for (size_t i = 0U; ok && (i < used); i++)
+        if (!(ok = add_to_hashtab(ht, &monkeys[i])))
+            fprintf(stderr, "Duplicate monkey %s or not enough memory!", monkeys[i].id);
+
+    /* part 1 */
+
+    if (ok)
+    {
+        clock_t t1 = clock();
+
+        uint64_t number = 0U;
+        ok = calc(ht, "root", used, &number);
+
+        clock_t t2 = clock();
+        if (ok)
+            solver_answer(result, 1U, "%llu", (unsigned long long) number);
+        else
+            fprintf(stderr, "Could not calculate number of root!");
+
+        double elapsed_time = (double)(t2 - t1) / CLOCKS_PER_SEC;
+        solver_log(log, "solving puzzle took %f s\n", elapsed_time);
+    }
+
+    ht_destroy(ht);
+    free(monkeys);
+
+    return ok;
+}
+
+static int
+add_monkey(data_t** monkeys, size_t* used, size_t* size, const data_t* data)
+{
+    if (*used >= *size)
+    {
+        size_t new_size = *size + CHUNK_SIZE;
+        data_t* new_monkeys = realloc(*monkeys, new_size * sizeof(data_t));
+        if (new_monkeys == NULL)
+            return 0;
+        *monkeys = new_monkeys;
+        *size = new_size;
+    }
+    (*monkeys)[(*used)++] = *data;
+
+    return 1;
+}
+
+static int
+add_to_hashtab(hashtable_t* ht, data_t* data)
+{
+    void* d = ht_read(ht, data->id);
+
+    if ((d != NULL) || (ht_write(ht, data->id, data) == NULL))
+        return 0;
+
+    return 1;
+}
+
+/* a chain of more monkeys than given can only be a cycle */
+static int
+calc(hashtable_t* ht, const char* key, size_t depth, uint64_t* number)
+{
+    data_t* d = ht_read(ht, key);
+    uint64_t l = 0U;
+    uint64_t r = 0U;
+
+    if ((d == NULL) || (depth == 0U))
+        return 0;
+    if (   (d->op != OP_NONE)
+        && (   !calc(ht, d->op_l, depth - 1U, &l)
+            || !calc(ht, d->op_r, depth - 1U, &r)))
+        return 0;
+
+    switch (d->op)
+    {
+        case OP_NONE:
+            *number = d->num;
+            break;
+        case OP_ADD:
+            *number = l + r;
+            break;
+        case OP_SUB:
+            *number = l - r;
+            break;
+        case OP_MUL:
+            *number = l * r;
+            break;
+        case OP_DIV:
+            if (r == 0U)
+                return 0;
+            *number = l / r;
+            break;
+        default:
+            assert(0);
+    }
+
+    return 1;
+}
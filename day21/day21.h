@@ -0,0 +1,17 @@
+/*
+ * Solver for advent of code 2022 day 21.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef DAY21_H_
+#define DAY21_H_
+
+#include "solver.h"
+
+extern const solver_t day21_solver;
+
+#endif /* DAY21_H_ */
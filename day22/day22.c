@@ -0,0 +1,583 @@
+/*
+ * Solver for advent of code 2022 day 22.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "day22.h"
+
+#include "grid.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define CELL(m, x, y) (*grid_at((m), (ptrdiff_t)(x), (ptrdiff_t)(y)))
+
+enum
+{
+    LEFT  = 0,
+    RIGHT = 1
+};
+
+typedef enum /* number equals score for result */
+{
+    EAST  = 0,
+    SOUTH = 1,
+    WEST  = 2,
+    NORTH = 3
+} compass_t;
+
+typedef struct
+{
+    size_t x;
+    size_t y;
+} coords_t;
+
+typedef struct
+{
+    coords_t  pos;
+    compass_t facing;
+} player_t;
+
+static const char dir[4] =
+{
+    [EAST]  = 'E',
+    [SOUTH] = 'S',
+    [WEST]  = 'W',
+    [NORTH] = 'N'
+};
+
+static const compass_t mapdir[2][4] =
+{
+    [LEFT] = {
+        [NORTH] = WEST,
+        [EAST]  = NORTH,
+        [SOUTH] = EAST,
+        [WEST]  = SOUTH
+    },
+    [RIGHT] = {
+        [NORTH] = EAST,
+        [EAST]  = SOUTH,
+        [SOUTH] = WEST,
+        [WEST]  = NORTH
+    }
+};
+
+static void*
+create(void);
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result);
+static void
+destroy(void* state);
+
+static int
+map_find_start(grid_t* m, player_t* p);
+static void
+map_print(grid_t* m);
+static void
+map_file(grid_t* m);
+
+static void
+player_turn(player_t* p, char d);
+static int
+player_move(player_t* p, grid_t* m, int s);
+
+static void
+player_move_right(player_t* p, grid_t* m, int s);
+static void
+player_move_left(player_t* p, grid_t* m, int s);
+static void
+player_move_up(player_t* p, grid_t* m, int s);
+static void
+player_move_down(player_t* p, grid_t* m, int s);
+
+static int
+wrap_r_to_l(const player_t* p, const grid_t* m, size_t* new_x);
+static int
+wrap_l_to_r(const player_t* p, const grid_t* m, size_t* new_x);
+static int
+wrap_b_to_t(const player_t* p, const grid_t* m, size_t* new_y);
+static int
+wrap_t_to_b(const player_t* p, const grid_t* m, size_t* new_y);
+
+const solver_t day22_solver =
+{
+    .name = "day22",
+    .title = "Day 22: Monkey Map",
+    .part =
+    {
+        "password",
+        "password"
+    },
+    .create = create,
+    .solve = solve,
+    .destroy = destroy
+};
+
+static void*
+create(void)
+{
+    grid_t* map = malloc(sizeof(grid_t));
+    if (map != NULL)
+        grid_init(map);
+    return map;
+}
+
+static int
+solve(void* state, FILE* fp, FILE* log, solver_result_t* result)
+{
+    grid_t* map = state;
+    player_t player;
+
+    /* the border of blanks lets the player wrap around at the edges */
+    if (!grid_read(map, fp, 1U, ' '))
+    {
+        fprintf(stderr, "Could not read map!\n");
+        return 0;
+    }
+
+    if (!map_find_start(map, &player))
+    {
+        fprintf(stderr, "Invalid map!\n");
+        return 0;
+    }
+    player.facing = EAST;
+
+    solver_log(log, "Start position: x=%llu y=%llu f=%c\n",
+               (unsigned long long) player.pos.x, (unsigned long long) player.pos.y,
+               dir[player.facing]);
+    solver_log(log, "Map size: max_x=%llu max_y=%llu\n",
+               (unsigned long long) map->width, (unsigned long long) map->height);
+
+    // map_print(map);
+
+    char c;
+    int num;
+    int count = 0;
+    while ((count = fscanf(fp, "%d%c", &num, &c)) >= 1)
+    {
+        // solver_log(log, "mov: steps=%d dir=%c\n", num, dir[player.facing]);
+        player_move(&player, map, num);
+        /* the path may end with a line break */
+        if ((count == 2) && (c != '\n') && (c != '\r'))
+        {
+            if ((c != 'L') && (c != 'R'))
+            {
+                fprintf(stderr, "Invalid turn '%c' in path!\n", c);
+                return 0;
+            }
+            player_turn(&player, c);
+        }
+        // solver_log(log, "pos: x=%llu y=%llu f=%c\n", player.pos.x, player.pos.y, dir[player.facing]);
+    }
+    if (count == 0)
+    {
+        fprintf(stderr, "Invalid path!\n");
+        return 0;
+    }
+    CELL(map, player.pos.x, player.pos.y) = 'E'; /* set end marker */
+
+    // map_to_file(map);
+
+    size_t pw = (1000U * (player.pos.y + 1U))
+              + (4U    * (player.pos.x + 1U))
+              + (size_t) player.facing;
+
+    solver_log(log, "End position: x=%llu y=%llu f=%d\n",
+               (unsigned long long) player.pos.x, (unsigned long long) player.pos.y,
+               player.facing);
+    solver_answer(result, 1U, "%llu", (unsigned long long) pw);
+
+    return 1;
+}
+
+static void
+destroy(void* state)
+{
+    grid_free(state);
+    free(state);
+}
+
+static int
+map_find_start(grid_t* m, player_t* p)
+{
+    int found = 0;
+    for (size_t y = 0U; y < m->height; y++)
+    {
+        for (size_t x = 0U; x < m->width; x++)
+        {
+            char c = CELL(m, x, y);
+            if ((c != ' ') && (c != '.') && (c != '#'))
+                return 0; /* tiles are open or walls only */
+            if (!found && (c == '.'))
+            {
+                p->pos.x = x;
+                p->pos.y = y;
+                found = 1;
+            }
+        }
+    }
+
+    return found;
+}
+
+static void
+map_print(grid_t* m)
+{
+    for (size_t y = 0U; y < m->height; y++)
+    {
+        for (size_t x = 0U; x < m->width; x++)
+        {
+            printf("%c", CELL(m, x, y));
+        }
+        putchar('\n');
+    }
+}
+
+static void
+map_to_file(grid_t* m)
+{
+    FILE* fp = fopen("map.txt", "w+");
+    if (!fp)
+        assert(0);
+
+    for (size_t y = 0U; y < m->height; y++)
+    {
+        for (size_t x = 0U; x < m->width; x++)
+        {
+            fprintf(fp, "%c", CELL(m, x, y));
+        }
+        fputc('\n', fp);
+    }
+
+    fclose(fp);
+}
+
+static void
+player_turn(player_t* p, char d)
+{
+    switch (d)
+    {
+        case 'L':
+            p->facing = mapdir[LEFT][p->facing];
+            break;
+        case 'R':
+            p->facing = mapdir[RIGHT][p->facing];
+            break;
+        default:
+            assert(0);
+    }
+}
+
+static int
+player_move(player_t* p, grid_t* m, int s)
+{
+    if (s <= 0)
+        return 0;
+
+    switch (p->facing)
+    {
+        case NORTH:
+            player_move_up(p, m, s);
+            break;
+        case EAST:
+            player_move_right(p, m, s);
+            break;
+        case SOUTH:
+            player_move_down(p, m, s);
+            break;
+        case WEST:
+            player_move_left(p, m, s);
+            break;
+        default:
+            assert(0);
+    }
+
+    return 1;
+}
+
+static void
+player_move_right(player_t* p, grid_t* m, int s)
+{
+    assert(s > 0);
+
+    int moving = 1;
+    while (moving)
+    {
+        if (CELL(m, p->pos.x + 1U, p->pos.y) == ' ')
+        {
+            size_t new_x = 0U;
+            int r = wrap_r_to_l(p, m, &new_x);
+            assert(r >= 0);
+            if (r == 0)
+            {
+                moving = 0;
+            }
+            else
+            {
+                CELL(m, p->pos.x, p->pos.y) = '>';
+                p->pos.x = new_x;
+                s--;
+                if (s <= 0)
+                    moving = 0;
+            }
+        }
+        else
+        {
+            if (CELL(m, p->pos.x + 1U, p->pos.y) == '#')
+            {
+                moving = 0;
+            }
+            else
+            {
+                CELL(m, p->pos.x, p->pos.y) = '>';
+                p->pos.x++;
+                s--;
+                if (s <= 0)
+                    moving = 0;
+            }
+        }
+    }
+}
+
+static void
+player_move_left(player_t* p, grid_t* m, int s)
+{
+    assert(s > 0);
+
+    int moving = 1;
+    while (moving)
+    {
+        if (CELL(m, (ptrdiff_t) p->pos.x - 1, p->pos.y) == ' ')
+        {
+            size_t new_x = 0U;
+            int r = wrap_l_to_r(p, m, &new_x);
+            assert(r >= 0);
+            if (r == 0)
+            {
+                moving = 0;
+            }
+            else
+            {
+                CELL(m, p->pos.x, p->pos.y) = '<';
+                p->pos.x = new_x;
+                s--;
+                if (s <= 0)
+                    moving = 0;
+            }
+        }
+        else
+        {
+            if (CELL(m, p->pos.x - 1U, p->pos.y) == '#')
+            {
+                moving = 0;
+            }
+            else
+            {
+                CELL(m, p->pos.x, p->pos.y) = '<';
+                p->pos.x--;
+                s--;
+                if (s <= 0)
+                    moving = 0;
+            }
+        }
+    }
+}
+
+static void
+player_move_up(player_t* p, grid_t* m, int s)
+{
+    assert(s > 0);
+
+    int moving = 1;
+    while (moving)
+    {
+        if (CELL(m, p->pos.x, (ptrdiff_t) p->pos.y - 1) == ' ')
+        {
+            size_t new_y = 0U;
+            int r = wrap_t_to_b(p, m, &new_y);
+            assert(r >= 0);
+            if (r == 0)
+            {
+                moving = 0;
+            }
+            else
+            {
+                CELL(m, p->pos.x, p->pos.y) = '^';
+                p->pos.y = new_y;
+                s--;
+                if (s <= 0)
+                    moving = 0;
+            }
+        }
+        else
+        {
+            if (CELL(m, p->pos.x, p->pos.y - 1U) == '#')
+            {
+                moving = 0;
+            }
+            else
+            {
+                CELL(m, p->pos.x, p->pos.y) = '^';
+                p->pos.y--;
+                s--;
+                if (s <= 0)
+                    moving = 0;
+            }
+        }
+    }
+}
+
+static void
+player_move_down(player_t* p, grid_t* m, int s)
+{
+    assert(s > 0);
+
+    int moving = 1;
+    while (moving)
+    {
+        if (CELL(m, p->pos.x, p->pos.y + 1U) == ' ')
+        {
+            size_t new_y = 0U;
+            int r = wrap_b_to_t(p, m, &new_y);
+            assert(r >= 0);
+            if (r == 0)
+            {
+                moving = 0;
+            }
+            else
+            {
+                CELL(m, p->pos.x, p->pos.y) = 'v';
+                p->pos.y = new_y;
+                s--;
+                if (s <= 0)
+                    moving = 0;
+            }
+        }
+        else
+        {
+            if (CELL(m, p->pos.x, p->pos.y + 1U) == '#')
+            {
+                moving = 0;
+            }
+            else
+            {
+                CELL(m, p->pos.x, p->pos.y) = 'v';
+                p->pos.y++;
+                s--;
+                if (s <= 0)
+                    moving = 0;
+            }
+        }
+    }
+}
+
+static int
+wrap_r_to_l(const player_t* p, const grid_t* m, size_t* new_x)
+{
+    for (size_t i = 0U; i <= p->pos.x; i++)
+    {
+        switch (CELL(m, i, p->pos.y))
+        {
+            case ' ':
+                break;
+            case '#':
+                return 0;
+            case '.':
+            case '<':
+            case '>':
+            case '^':
+            case 'v':
+                *new_x = i;
+                return 1;
+            default:
+                return -1;
+        }
+    }
+
+    return -1;
+}
+
+static int
+wrap_l_to_r(const player_t* p, const grid_t* m, size_t* new_x)
+{
+    for (size_t i = m->width; i-- > 0U; )
+    {
+        switch (CELL(m, i, p->pos.y))
+        {
+            case ' ':
+                break;
+            case '#':
+                return 0;
+            case '.':
+            case '<':
+            case '>':
+            case '^':
+            case 'v':
+                *new_x = i;
+                return 1;
+            default:
+                return -1;
+        }
+    }
+
+    return -1;
+}
+
+static int
+wrap_b_to_t(const player_t* p, const grid_t* m, size_t* new_y)
+{
+    for (size_t i = 0U; i <= p->pos.y; i++)
+    {
+        switch (CELL(m, p->pos.x, i))
+        {
+            case ' ':
+                break;
+            case '#':
+                return 0;
+            case '.':
+            case '<':
+            case '>':
+            case '^':
+            case 'v':
+                *new_y = i;
+                return 1;
+            default:
+                return -1;
+        }
+    }
+
+    return -1;
+}
+
+static int
+wrap_t_to_b(const player_t* p, const grid_t* m, size_t* new_y)
+{
+    for (size_t i = m->height; i-- > 0U; )
+    {
+        switch (CELL(m, p->pos.x, i))
+        {
+            case ' ':
+                break;
+            case '#':
+                return 0;
+            case '.':
+            case '<':
+            case '>':
+            case '^':
+            case 'v':
+                *new_y = i;
+                return 1;
+            default:
+                return -1;
+        }
+    }
+
+    return -1;
+}
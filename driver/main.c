@@ -0,0 +1,32 @@
+/*
+ * Shared driver program for all days of advent of code 2022.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "solvers.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char *argv[])
+{
+    const solver_t* solver = (argc >= 2) ? solvers_find(argv[1]) : NULL;
+
+    if (solver == NULL)
+    {
+        fprintf(stderr, "Usage: %s day [-b] [-j threads] [-m manifest] file...\n", argv[0]);
+        fprintf(stderr, "Available days:");
+        const solver_t* s;
+        for (size_t i = 0U; (s = solvers_get(i)) != NULL; i++)
+            fprintf(stderr, " %s", s->name);
+        fprintf(stderr, "\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* pass all remaining arguments, the day takes the place of the program */
+    return solver_main(solver, argc - 1, &argv[1]);
+}
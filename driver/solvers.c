@@ -0,0 +1,75 @@
+/*
+ * Registry of all puzzle solvers.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "solvers.h"
+
+#include "day01.h"
+#include "day02.h"
+#include "day03.h"
+#include "day04.h"
+#include "day05.h"
+#include "day06.h"
+#include "day07.h"
+#include "day08.h"
+#include "day09.h"
+#include "day10.h"
+#include "day11.h"
+#include "day12.h"
+#include "day14.h"
+#include "day15.h"
+#include "day17.h"
+#include "day18.h"
+#include "day20.h"
+#include "day21.h"
+#include "day22.h"
+#include "day25.h"
+
+#include <string.h>
+
+static const solver_t* const solvers[] =
+{
+    &day01_solver,
+    &day02_solver,
+    &day03_solver,
+    &day04_solver,
+    &day05_solver,
+    &day06_solver,
+    &day07_solver,
+    &day08_solver,
+    &day09_solver,
+    &day10_solver,
+    &day11_solver,
+    &day12_solver,
+    &day14_solver,
+    &day15_solver,
+    &day17_solver,
+    &day18_solver,
+    &day20_solver,
+    &day21_solver,
+    &day22_solver,
+    &day25_solver
+};
+
+#define NUM_SOLVERS (sizeof(solvers) / sizeof(solvers[0]))
+
+const solver_t*
+solvers_find(const char* name)
+{
+    for (size_t i = 0U; i < NUM_SOLVERS; i++)
+        if (strcmp(solvers[i]->name, name) == 0)
+            return solvers[i];
+
+    return NULL;
+}
+
+const solver_t*
+solvers_get(size_t i)
+{
+    return (i < NUM_SOLVERS) ? solvers[i] : NULL;
+}
@@ -0,0 +1,35 @@
+/*
+ * Registry of all puzzle solvers.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef SOLVERS_H_
+#define SOLVERS_H_
+
+#include "solver.h"
+
+/**
+ * \brief Find solver by name.
+ *
+ * \param[in] name Name of the solver, e.g. "day01".
+ *
+ * \return const solver_t* Solver or NULL if not found.
+ */
+const solver_t*
+solvers_find(const char* name);
+
+/**
+ * \brief Get solver by index.
+ *
+ * \param[in] i Index, starting at 0.
+ *
+ * \return const solver_t* Solver or NULL if index out of range.
+ */
+const solver_t*
+solvers_get(size_t i);
+
+#endif /* SOLVERS_H_ */
@@ -15,6 +15,7 @@ CFLAGS =\
 	-Wall\
 	-Wextra\
 	-Wpedantic\
+	-pthread\
 	-fsanitize=undefined\
 	-fsanitize-undefined-trap-on-error
 CFLAGS_RELEASE = -DNDEBUG
@@ -25,6 +26,7 @@ CFLAGS_DEBUG = -g
 LD=gcc
 
 LDFLAGS =\
+	-pthread\
 	-fsanitize=undefined\
 	-fsanitize-undefined-trap-on-error
 LDFLAGS_RELEASE = -Wl,-Map -Wl,release/$(TARGET_NAME).map
@@ -0,0 +1,336 @@
+/*
+ * Sets of bits and two-/three-dimensional bit matrices.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "bitset.h"
+
+#include <assert.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+typedef enum
+{
+    OP_AND,
+    OP_OR,
+    OP_ANDNOT
+} op_t;
+
+static void
+bitset_apply(bitset_t* dst, const bitset_t* a, const bitset_t* b, op_t op);
+
+static void
+bitset_clear_tail(bitset_t* b);
+
+static size_t
+popcount(uint64_t w);
+
+static size_t
+ctz(uint64_t w);
+
+void
+bitset_init(bitset_t* b)
+{
+    assert(b != NULL);
+
+    memset(b, 0, sizeof(bitset_t));
+}
+
+int
+bitset_resize(bitset_t* b, size_t bits)
+{
+    assert(b != NULL);
+
+    size_t used = (bits + (BITSET_WORD_BITS - 1U)) / BITSET_WORD_BITS;
+    if (used > b->size)
+    {
+        /* grow at least by half, sets may grow in small steps */
+        size_t size = b->size + (b->size / 2U);
+        if (size < used)
+            size = used;
+        uint64_t* words = realloc(b->words, size * sizeof(uint64_t));
+        if (words == NULL)
+            return 0;
+        b->words = words;
+        b->size = size;
+    }
+
+    /* new words may contain bits of a former use */
+    if (used > b->used)
+        memset(&b->words[b->used], 0, (used - b->used) * sizeof(uint64_t));
+    b->bits = bits;
+    b->used = used;
+    bitset_clear_tail(b);
+
+    return 1;
+}
+
+void
+bitset_clear(bitset_t* b)
+{
+    assert(b != NULL);
+
+    if (b->used > 0U)
+        memset(b->words, 0, b->used * sizeof(uint64_t));
+}
+
+void
+bitset_copy(bitset_t* dst, const bitset_t* src)
+{
+    assert(dst != NULL);
+    assert(src != NULL);
+    assert(dst->bits == src->bits);
+
+    if (src->used > 0U)
+        memcpy(dst->words, src->words, src->used * sizeof(uint64_t));
+}
+
+void
+bitset_and(bitset_t* dst, const bitset_t* a, const bitset_t* b)
+{
+    bitset_apply(dst, a, b, OP_AND);
+}
+
+void
+bitset_or(bitset_t* dst, const bitset_t* a, const bitset_t* b)
+{
+    bitset_apply(dst, a, b, OP_OR);
+}
+
+void
+bitset_andnot(bitset_t* dst, const bitset_t* a, const bitset_t* b)
+{
+    bitset_apply(dst, a, b, OP_ANDNOT);
+}
+
+void
+bitset_shift_up(bitset_t* dst, const bitset_t* src, size_t n)
+{
+    assert(dst != NULL);
+    assert(src != NULL);
+    assert(dst != src);
+    assert(dst->bits == src->bits);
+
+    size_t w = n / BITSET_WORD_BITS;
+    unsigned int s = (unsigned int)(n % BITSET_WORD_BITS);
+
+    for (size_t i = 0U; i < src->used; i++)
+    {
+        uint64_t v = 0U;
+        if (i >= w)
+        {
+            v = src->words[i - w] << s;
+            if ((s > 0U) && (i > w))
+                v |= src->words[i - w - 1U] >> (BITSET_WORD_BITS - s);
+        }
+        dst->words[i] = v;
+    }
+    bitset_clear_tail(dst);
+}
+
+void
+bitset_shift_down(bitset_t* dst, const bitset_t* src, size_t n)
+{
+    assert(dst != NULL);
+    assert(src != NULL);
+    assert(dst != src);
+    assert(dst->bits == src->bits);
+
+    size_t w = n / BITSET_WORD_BITS;
+    unsigned int s = (unsigned int)(n % BITSET_WORD_BITS);
+
+    for (size_t i = 0U; i < src->used; i++)
+    {
+        uint64_t v = 0U;
+        if ((i + w) < src->used)
+        {
+            v = src->words[i + w] >> s;
+            if ((s > 0U) && ((i + w + 1U) < src->used))
+                v |= src->words[i + w + 1U] << (BITSET_WORD_BITS - s);
+        }
+        dst->words[i] = v;
+    }
+}
+
+size_t
+bitset_count(const bitset_t* b)
+{
+    assert(b != NULL);
+
+    size_t n = 0U;
+    for (size_t i = 0U; i < b->used; i++)
+        n += popcount(b->words[i]);
+
+    return n;
+}
+
+size_t
+bitset_find_next(const bitset_t* b, size_t from)
+{
+    assert(b != NULL);
+
+    if (from >= b->bits)
+        return b->bits;
+
+    size_t i = from / BITSET_WORD_BITS;
+    uint64_t w = b->words[i] & (~(uint64_t) 0U << (from % BITSET_WORD_BITS));
+    for (;;)
+    {
+        if (w != 0U)
+            return (i * BITSET_WORD_BITS) + ctz(w);
+        if (++i >= b->used)
+            return b->bits;
+        w = b->words[i];
+    }
+}
+
+void
+bitset_free(bitset_t* b)
+{
+    assert(b != NULL);
+
+    free(b->words);
+    bitset_init(b);
+}
+
+void
+bitmatrix_init(bitmatrix_t* m)
+{
+    assert(m != NULL);
+
+    bitset_init(&m->bits);
+    m->width = 0U;
+    m->height = 0U;
+    m->depth = 0U;
+    m->row_words = 0U;
+}
+
+int
+bitmatrix_resize(bitmatrix_t* m, size_t width, size_t height, size_t depth)
+{
+    assert(m != NULL);
+
+    int keep = (width == m->width) && (depth == m->depth) && (depth == 1U);
+    size_t row_words = (width + (BITSET_WORD_BITS - 1U)) / BITSET_WORD_BITS;
+    size_t rows = height * depth;
+    if ((rows > 0U) && (row_words > (SIZE_MAX / BITSET_WORD_BITS / rows)))
+        return 0;
+
+    if (!bitset_resize(&m->bits, rows * row_words * BITSET_WORD_BITS))
+        return 0;
+    if (!keep)
+        bitset_clear(&m->bits);
+
+    m->width = width;
+    m->height = height;
+    m->depth = depth;
+    m->row_words = row_words;
+
+    return 1;
+}
+
+void
+bitmatrix_free(bitmatrix_t* m)
+{
+    assert(m != NULL);
+
+    bitset_free(&m->bits);
+    bitmatrix_init(m);
+}
+
+static void
+bitset_apply(bitset_t* dst, const bitset_t* a, const bitset_t* b, op_t op)
+{
+    assert(dst != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+    assert((dst->bits == a->bits) && (a->bits == b->bits));
+
+    size_t i = 0U;
+    size_t n = a->used;
+
+#if defined(__AVX2__)
+    for (; (i + 4U) <= n; i += 4U)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i*) &a->words[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*) &b->words[i]);
+        __m256i vr;
+        switch (op)
+        {
+            case OP_AND:
+                vr = _mm256_and_si256(va, vb);
+                break;
+            case OP_OR:
+                vr = _mm256_or_si256(va, vb);
+                break;
+            default:
+                vr = _mm256_andnot_si256(vb, va); /* ~vb & va */
+                break;
+        }
+        _mm256_storeu_si256((__m256i*) &dst->words[i], vr);
+    }
+#endif
+
+    switch (op)
+    {
+        case OP_AND:
+            for (; i < n; i++)
+                dst->words[i] = a->words[i] & b->words[i];
+            break;
+        case OP_OR:
+            for (; i < n; i++)
+                dst->words[i] = a->words[i] | b->words[i];
+            break;
+        default:
+            for (; i < n; i++)
+                dst->words[i] = a->words[i] & ~b->words[i];
+            break;
+    }
+}
+
+static void
+bitset_clear_tail(bitset_t* b)
+{
+    size_t r = b->bits % BITSET_WORD_BITS;
+    if (r > 0U)
+        b->words[b->used - 1U] &= ((uint64_t) 1U << r) - 1U;
+}
+
+static size_t
+popcount(uint64_t w)
+{
+#if defined(__GNUC__)
+    return (size_t) __builtin_popcountll(w);
+#else
+    /* https://en.wikipedia.org/wiki/Hamming_weight */
+    w = w - ((w >> 1) & 0x5555555555555555U);
+    w = (w & 0x3333333333333333U) + ((w >> 2) & 0x3333333333333333U);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FU;
+    return (size_t)((w * 0x0101010101010101U) >> 56);
+#endif
+}
+
+static size_t
+ctz(uint64_t w)
+{
+    assert(w != 0U);
+
+#if defined(__GNUC__)
+    return (size_t) __builtin_ctzll(w);
+#else
+    size_t n = 0U;
+    while ((w & 1U) == 0U)
+    {
+        w >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
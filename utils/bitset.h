@@ -0,0 +1,270 @@
+/*
+ * Sets of bits and two-/three-dimensional bit matrices.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef BITSET_H_
+#define BITSET_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define BITSET_WORD_BITS (64U)
+
+/**
+ * \brief Set of bits, stored in 64 bit words.
+ *
+ * Bits beyond the size of the set are always cleared, so operations work on
+ * whole words. The set operations use AVX2 if compiled with -mavx2. Memory
+ * only grows, so a set can be reused for many inputs.
+ */
+typedef struct
+{
+    uint64_t* words;
+    size_t bits;      /* number of bits */
+    size_t used;      /* number of words in use */
+    size_t size;      /* number of words allocated */
+} bitset_t;
+
+/**
+ * \brief Bit matrix of width x height x depth bits, stored row by row.
+ *
+ * Each row starts at a new word, so rows can be accessed word by word. A 2D
+ * matrix has a depth of 1. The padding bits at the end of each row belong to
+ * the set as well, shifting the set may move bits into them.
+ */
+typedef struct
+{
+    bitset_t bits;
+    size_t width;
+    size_t height;
+    size_t depth;
+    size_t row_words; /* number of words per row */
+} bitmatrix_t;
+
+/**
+ * \brief Initialize an empty set, nothing is allocated.
+ *
+ * \param[out] b Set.
+ */
+void
+bitset_init(bitset_t* b);
+
+/**
+ * \brief Change the number of bits, existing bits are kept, new are cleared.
+ *
+ * \param[in,out] b    Set.
+ * \param[in]     bits Number of bits.
+ *
+ * \return int
+ * \retval 0 Failure, not enough memory.
+ * \retval 1 Success.
+ */
+int
+bitset_resize(bitset_t* b, size_t bits);
+
+/**
+ * \brief Clear all bits.
+ *
+ * \param[in,out] b Set.
+ */
+void
+bitset_clear(bitset_t* b);
+
+/**
+ * \brief Copy all bits, both sets must have the same size.
+ *
+ * \param[out] dst Destination.
+ * \param[in]  src Source.
+ */
+void
+bitset_copy(bitset_t* dst, const bitset_t* src);
+
+/**
+ * \brief dst = a & b, all sets must have the same size.
+ *
+ * \param[out] dst Result, may be one of the operands.
+ * \param[in]  a   First operand.
+ * \param[in]  b   Second operand.
+ */
+void
+bitset_and(bitset_t* dst, const bitset_t* a, const bitset_t* b);
+
+/**
+ * \brief dst = a | b, all sets must have the same size.
+ *
+ * \param[out] dst Result, may be one of the operands.
+ * \param[in]  a   First operand.
+ * \param[in]  b   Second operand.
+ */
+void
+bitset_or(bitset_t* dst, const bitset_t* a, const bitset_t* b);
+
+/**
+ * \brief dst = a & ~b, all sets must have the same size.
+ *
+ * \param[out] dst Result, may be one of the operands.
+ * \param[in]  a   First operand.
+ * \param[in]  b   Second operand.
+ */
+void
+bitset_andnot(bitset_t* dst, const bitset_t* a, const bitset_t* b);
+
+/**
+ * \brief Shift all bits towards higher indices, dst[i + n] = src[i].
+ *
+ * \param[out] dst Result, must not be src, same size as src.
+ * \param[in]  src Source.
+ * \param[in]  n   Number of bits to shift.
+ */
+void
+bitset_shift_up(bitset_t* dst, const bitset_t* src, size_t n);
+
+/**
+ * \brief Shift all bits towards lower indices, dst[i] = src[i + n].
+ *
+ * \param[out] dst Result, must not be src, same size as src.
+ * \param[in]  src Source.
+ * \param[in]  n   Number of bits to shift.
+ */
+void
+bitset_shift_down(bitset_t* dst, const bitset_t* src, size_t n);
+
+/**
+ * \brief Count set bits.
+ *
+ * \param[in] b Set.
+ *
+ * \return size_t Number of set bits.
+ */
+size_t
+bitset_count(const bitset_t* b);
+
+/**
+ * \brief Find the first set bit at or after given index.
+ *
+ * \param[in] b    Set.
+ * \param[in] from Index to start at.
+ *
+ * \return size_t Index of the bit or number of bits of the set if none found.
+ */
+size_t
+bitset_find_next(const bitset_t* b, size_t from);
+
+/**
+ * \brief Free memory of the set, it is empty afterwards.
+ *
+ * \param[in,out] b Set.
+ */
+void
+bitset_free(bitset_t* b);
+
+/**
+ * \brief Initialize an empty matrix, nothing is allocated.
+ *
+ * \param[out] m Matrix.
+ */
+void
+bitmatrix_init(bitmatrix_t* m);
+
+/**
+ * \brief Set dimensions of the matrix.
+ *
+ * Only if the width and depth stay the same and the depth is 1, i.e. rows are
+ * added to or removed from a 2D matrix, the remaining bits are kept. Otherwise
+ * all bits are cleared.
+ *
+ * \param[in,out] m      Matrix.
+ * \param[in]     width  Number of columns.
+ * \param[in]     height Number of rows.
+ * \param[in]     depth  Number of planes, 1 for a 2D matrix.
+ *
+ * \return int
+ * \retval 0 Failure, not enough memory.
+ * \retval 1 Success.
+ */
+int
+bitmatrix_resize(bitmatrix_t* m, size_t width, size_t height, size_t depth);
+
+/**
+ * \brief Free memory of the matrix, it is empty afterwards.
+ *
+ * \param[in,out] m Matrix.
+ */
+void
+bitmatrix_free(bitmatrix_t* m);
+
+/**
+ * \brief Test a bit.
+ *
+ * \param[in] b Set.
+ * \param[in] i Index of the bit.
+ *
+ * \return int 1 if set, 0 otherwise.
+ */
+static inline int
+bitset_test(const bitset_t* b, size_t i)
+{
+    return (int)((b->words[i / BITSET_WORD_BITS] >> (i % BITSET_WORD_BITS)) & 1U);
+}
+
+/**
+ * \brief Set a bit.
+ *
+ * \param[in,out] b Set.
+ * \param[in]     i Index of the bit.
+ */
+static inline void
+bitset_set(bitset_t* b, size_t i)
+{
+    b->words[i / BITSET_WORD_BITS] |= (uint64_t) 1U << (i % BITSET_WORD_BITS);
+}
+
+/**
+ * \brief Clear a bit.
+ *
+ * \param[in,out] b Set.
+ * \param[in]     i Index of the bit.
+ */
+static inline void
+bitset_reset(bitset_t* b, size_t i)
+{
+    b->words[i / BITSET_WORD_BITS] &= ~((uint64_t) 1U << (i % BITSET_WORD_BITS));
+}
+
+/**
+ * \brief Get index of a bit of the matrix within its set.
+ *
+ * \param[in] m Matrix.
+ * \param[in] x Column.
+ * \param[in] y Row.
+ * \param[in] z Plane, 0 for a 2D matrix.
+ *
+ * \return size_t Index.
+ */
+static inline size_t
+bitmatrix_index(const bitmatrix_t* m, size_t x, size_t y, size_t z)
+{
+    return (((z * m->height) + y) * m->row_words * BITSET_WORD_BITS) + x;
+}
+
+/**
+ * \brief Get first word of a row of the matrix.
+ *
+ * \param[in] m Matrix.
+ * \param[in] y Row.
+ * \param[in] z Plane, 0 for a 2D matrix.
+ *
+ * \return uint64_t* Words of the row, bit 0 of the first word is column 0.
+ */
+static inline uint64_t*
+bitmatrix_row(const bitmatrix_t* m, size_t y, size_t z)
+{
+    return &m->bits.words[((z * m->height) + y) * m->row_words];
+}
+
+#endif /* BITSET_H_ */
@@ -0,0 +1,197 @@
+/*
+ * Two-dimensional grid of characters with runtime dimensions.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#include "grid.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEXT_CHUNK_SIZE (4096U)
+
+static size_t
+align_up(size_t n);
+
+static char*
+grid_base(const grid_t* g);
+
+static size_t
+grid_rows(const grid_t* g);
+
+static int
+text_append(grid_t* g, size_t* used, char c);
+
+void
+grid_init(grid_t* g)
+{
+    assert(g != NULL);
+
+    memset(g, 0, sizeof(grid_t));
+}
+
+int
+grid_resize(grid_t* g, size_t width, size_t height, size_t border, char fill)
+{
+    assert(g != NULL);
+
+    /* the left border is widened, so that each row starts aligned */
+    size_t left = align_up(border);
+    size_t stride = align_up(left + width + border);
+    size_t rows = height + (2U * border);
+    if ((rows > 0U) && (stride > ((SIZE_MAX - GRID_ALIGN) / rows)))
+        return 0;
+
+    size_t size = (rows * stride) + GRID_ALIGN;
+    if (size > g->size)
+    {
+        char* mem = malloc(size);
+        if (mem == NULL)
+            return 0;
+        free(g->mem);
+        g->mem = mem;
+        g->size = size;
+    }
+
+    uintptr_t base = ((uintptr_t) g->mem + (GRID_ALIGN - 1U)) & ~((uintptr_t) GRID_ALIGN - 1U);
+    g->cells = (char*) base + (border * stride) + left;
+    g->width = width;
+    g->height = height;
+    g->stride = stride;
+    g->border = border;
+
+    grid_fill(g, fill);
+
+    return 1;
+}
+
+int
+grid_read(grid_t* g, FILE* fp, size_t border, char fill)
+{
+    assert(g != NULL);
+    assert(fp != NULL);
+
+    size_t used = 0U;
+    size_t width = 0U;
+    size_t height = 0U;
+    size_t len = 0U;
+    int c;
+    while ((c = fgetc(fp)) != EOF)
+    {
+        if (c == '\r')
+            continue;
+        if (c == '\n')
+        {
+            if (len == 0U) /* consume empty line separator */
+                break;
+            if (len > width)
+                width = len;
+            height++;
+            len = 0U;
+        }
+        else
+        {
+            len++;
+        }
+        if (!text_append(g, &used, (char) c))
+            return 0;
+    }
+    if (len > 0U) /* last line without EOL */
+    {
+        if (len > width)
+            width = len;
+        height++;
+        if (!text_append(g, &used, '\n'))
+            return 0;
+    }
+
+    if ((height == 0U) || !grid_resize(g, width, height, border, fill))
+        return 0;
+
+    const char* line = g->text;
+    for (size_t y = 0U; y < height; y++)
+    {
+        const char* eol = memchr(line, '\n', used - (size_t)(line - g->text));
+        assert(eol != NULL);
+        memcpy(grid_at(g, 0, (ptrdiff_t) y), line, (size_t)(eol - line));
+        line = eol + 1;
+    }
+
+    return 1;
+}
+
+int
+grid_copy(grid_t* dst, const grid_t* src)
+{
+    assert(dst != NULL);
+    assert(src != NULL);
+
+    if (!grid_resize(dst, src->width, src->height, src->border, '\0'))
+        return 0;
+
+    /* same dimensions result in the same layout */
+    memcpy(grid_base(dst), grid_base(src), grid_rows(src) * src->stride);
+
+    return 1;
+}
+
+void
+grid_fill(grid_t* g, char fill)
+{
+    assert(g != NULL);
+
+    if (g->cells != NULL)
+        memset(grid_base(g), fill, grid_rows(g) * g->stride);
+}
+
+void
+grid_free(grid_t* g)
+{
+    assert(g != NULL);
+
+    free(g->mem);
+    free(g->text);
+    grid_init(g);
+}
+
+static size_t
+align_up(size_t n)
+{
+    return (n + (GRID_ALIGN - 1U)) & ~((size_t) GRID_ALIGN - 1U);
+}
+
+static char*
+grid_base(const grid_t* g)
+{
+    return g->cells - (g->border * g->stride) - align_up(g->border);
+}
+
+static size_t
+grid_rows(const grid_t* g)
+{
+    return g->height + (2U * g->border);
+}
+
+static int
+text_append(grid_t* g, size_t* used, char c)
+{
+    if (*used >= g->text_size)
+    {
+        size_t size = (g->text_size > 0U) ? (2U * g->text_size) : TEXT_CHUNK_SIZE;
+        char* text = realloc(g->text, size);
+        if (text == NULL)
+            return 0;
+        g->text = text;
+        g->text_size = size;
+    }
+
+    g->text[(*used)++] = c;
+
+    return 1;
+}
@@ -0,0 +1,128 @@
+/*
+ * Two-dimensional grid of characters with runtime dimensions.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef GRID_H_
+#define GRID_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define GRID_ALIGN (32U) /* alignment of each row in bytes */
+
+/**
+ * \brief Grid of width x height cells, stored row by row.
+ *
+ * Each row starts at an address aligned to GRID_ALIGN. The grid may be
+ * surrounded by a border of sentinel cells, which are accessible by negative
+ * coordinates or coordinates beyond width/height, so neighbours of any cell
+ * can be read without bounds checks. The memory is kept on resizing and only
+ * grows, so a grid can be reused for many inputs.
+ */
+typedef struct
+{
+    char* cells;    /* cell (0, 0) */
+    size_t width;
+    size_t height;
+    size_t stride;  /* distance between two rows in cells */
+    size_t border;  /* number of sentinel cells on each side */
+    char* mem;      /* allocated memory */
+    size_t size;    /* size of allocated memory */
+    char* text;     /* line buffer of grid_read() */
+    size_t text_size;
+} grid_t;
+
+/**
+ * \brief Initialize an empty grid, nothing is allocated.
+ *
+ * \param[out] g Grid.
+ */
+void
+grid_init(grid_t* g);
+
+/**
+ * \brief Set dimensions of the grid and fill all cells including the border.
+ *
+ * \param[in,out] g      Grid.
+ * \param[in]     width  Number of columns.
+ * \param[in]     height Number of rows.
+ * \param[in]     border Number of sentinel cells on each side, may be 0.
+ * \param[in]     fill   Value of all cells.
+ *
+ * \return int
+ * \retval 0 Failure, not enough memory.
+ * \retval 1 Success.
+ */
+int
+grid_resize(grid_t* g, size_t width, size_t height, size_t border, char fill);
+
+/**
+ * \brief Read grid from text, one row per line.
+ *
+ * Reading stops at the end of the file or after the first empty line. The
+ * width of the grid is given by the longest line, shorter lines are padded
+ * with the fill value, as well as the border.
+ *
+ * \param[in,out] g      Grid.
+ * \param[in]     fp     Stream to read from.
+ * \param[in]     border Number of sentinel cells on each side, may be 0.
+ * \param[in]     fill   Value of padding and border.
+ *
+ * \return int
+ * \retval 0 Failure, no lines or not enough memory.
+ * \retval 1 Success.
+ */
+int
+grid_read(grid_t* g, FILE* fp, size_t border, char fill);
+
+/**
+ * \brief Copy dimensions and all cells including the border.
+ *
+ * \param[in,out] dst Grid to copy to.
+ * \param[in]     src Grid to copy from.
+ *
+ * \return int
+ * \retval 0 Failure, not enough memory.
+ * \retval 1 Success.
+ */
+int
+grid_copy(grid_t* dst, const grid_t* src);
+
+/**
+ * \brief Set all cells including the border.
+ *
+ * \param[in,out] g    Grid.
+ * \param[in]     fill Value of all cells.
+ */
+void
+grid_fill(grid_t* g, char fill);
+
+/**
+ * \brief Free memory of the grid, it is empty afterwards.
+ *
+ * \param[in,out] g Grid.
+ */
+void
+grid_free(grid_t* g);
+
+/**
+ * \brief Get cell, coordinates of the border are valid.
+ *
+ * \param[in] g Grid.
+ * \param[in] x Column, -border <= x < width + border.
+ * \param[in] y Row, -border <= y < height + border.
+ *
+ * \return char* Cell.
+ */
+static inline char*
+grid_at(const grid_t* g, ptrdiff_t x, ptrdiff_t y)
+{
+    return g->cells + (y * (ptrdiff_t) g->stride) + x;
+}
+
+#endif /* GRID_H_ */
@@ -7,6 +7,8 @@
  * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "hashtable.h"
 
 #include <assert.h>
@@ -0,0 +1,66 @@
+/*
+ * Read-only memory mapping of a whole file (POSIX).
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mapping.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int
+mapping_open(mapping_t* m, const char* name)
+{
+    assert(m != NULL);
+    assert(name != NULL);
+
+    m->text = NULL;
+    m->size = 0U;
+
+    int fd = open(name, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return 0;
+    }
+
+    if (st.st_size > 0)
+    {
+        void* p = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            close(fd);
+            return 0;
+        }
+        (void) posix_madvise(p, (size_t) st.st_size, POSIX_MADV_SEQUENTIAL);
+        m->text = p;
+        m->size = (size_t) st.st_size;
+    }
+    close(fd); /* the mapping stays valid */
+
+    return 1;
+}
+
+void
+mapping_close(mapping_t* m)
+{
+    assert(m != NULL);
+
+    if (m->text != NULL)
+        munmap((void*) m->text, m->size);
+    m->text = NULL;
+    m->size = 0U;
+}
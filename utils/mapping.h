@@ -0,0 +1,48 @@
+/*
+ * Read-only memory mapping of a whole file (POSIX).
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef MAPPING_H_
+#define MAPPING_H_
+
+#include <stdlib.h>
+
+/**
+ * \brief File mapped into memory.
+ *
+ * Large inputs can be split into chunks and processed by several threads
+ * without copying them.
+ */
+typedef struct
+{
+    const char* text;  /* contents, NULL if the file is empty */
+    size_t size;       /* size in bytes */
+} mapping_t;
+
+/**
+ * \brief Map a whole file read-only, an empty file results in an empty mapping.
+ *
+ * \param[out] m    Mapping.
+ * \param[in]  name Name of the file.
+ *
+ * \return int
+ * \retval 0 Failure, file could not be opened or mapped.
+ * \retval 1 Success.
+ */
+int
+mapping_open(mapping_t* m, const char* name);
+
+/**
+ * \brief Unmap the file, the mapping is empty afterwards.
+ *
+ * \param[in,out] m Mapping.
+ */
+void
+mapping_close(mapping_t* m);
+
+#endif /* MAPPING_H_ */
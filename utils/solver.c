@@ -0,0 +1,385 @@
+/*
+ * Common interface of all puzzle solvers and batch processing of inputs.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "solver.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <string.h>
+
+#define MAX_LINE_SIZE (4096U) /* max line length of manifest, incl. EOL */
+#define CHUNK_SIZE    (64U)
+#define MAX_THREADS   (256U)
+
+typedef struct
+{
+    char** names;
+    size_t used;
+    size_t size;
+} file_list_t;
+
+typedef struct
+{
+    const solver_t* solver;
+    const file_list_t* files;
+    solver_result_t* results;
+    int* success;
+    int parallel;
+    size_t next;
+    pthread_mutex_t lock;
+} batch_t;
+
+static int
+file_list_add(file_list_t* fl, const char* name);
+
+static int
+file_list_read_manifest(file_list_t* fl, const char* manifest);
+
+static void
+file_list_free(file_list_t* fl);
+
+static int
+solve_file(const solver_t* s, void* state, const char* name, FILE* log,
+           solver_result_t* result);
+
+static int
+run_verbose(const solver_t* s, const char* name);
+
+static int
+run_batch(const solver_t* s, const file_list_t* fl, size_t threads);
+
+static void*
+batch_worker(void* arg);
+
+int
+solver_main(const solver_t* solver, int argc, char* argv[])
+{
+    assert(solver != NULL);
+
+    file_list_t files = {0};
+    int batch = 0;
+    unsigned int threads = 1U;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((argv[i][0] == '-') && (argv[i][1] != '\0'))
+        {
+            switch (argv[i][1])
+            {
+                case 'b':
+                    batch = 1;
+                    break;
+                case 'j':
+                    if (   ((i + 1) >= argc)
+                        || (sscanf(argv[i + 1], "%u", &threads) != 1)
+                        || (threads == 0U)
+                        || (threads > MAX_THREADS))
+                    {
+                        fprintf(stderr, "Invalid number of threads!\n");
+                        file_list_free(&files);
+                        return EXIT_FAILURE;
+                    }
+                    batch = 1;
+                    i++;
+                    break;
+                case 'm':
+                    if (   ((i + 1) >= argc)
+                        || !file_list_read_manifest(&files, argv[i + 1]))
+                    {
+                        fprintf(stderr, "Could not read manifest!\n");
+                        file_list_free(&files);
+                        return EXIT_FAILURE;
+                    }
+                    batch = 1;
+                    i++;
+                    break;
+                default:
+                    fprintf(stderr, "Unknown option %s!\n", argv[i]);
+                    file_list_free(&files);
+                    return EXIT_FAILURE;
+            }
+        }
+        else if (!file_list_add(&files, argv[i]))
+        {
+            fprintf(stderr, "Not enough memory!\n");
+            file_list_free(&files);
+            return EXIT_FAILURE;
+        }
+    }
+
+    int r;
+    if ((files.used == 1U) && !batch)
+    {
+        r = run_verbose(solver, files.names[0]);
+    }
+    else if (files.used > 0U)
+    {
+        r = run_batch(solver, &files, threads);
+    }
+    else
+    {
+        printf("Advent of Code 2022 - %s\n\n", solver->title);
+        fprintf(stderr, "Please provide data record file name.");
+        r = 0;
+    }
+
+    file_list_free(&files);
+
+    return r ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void
+solver_answer(solver_result_t* result, size_t part, const char* format, ...)
+{
+    assert(result != NULL);
+    assert((part >= 1U) && (part <= SOLVER_NUM_PARTS));
+
+    va_list args;
+    va_start(args, format);
+    (void) vsnprintf(result->answer[part - 1U], SOLVER_ANSWER_SIZE, format, args);
+    va_end(args);
+}
+
+void
+solver_log(FILE* log, const char* format, ...)
+{
+    if (log == NULL)
+        return;
+
+    va_list args;
+    va_start(args, format);
+    (void) vfprintf(log, format, args);
+    va_end(args);
+}
+
+void
+solver_print_line(FILE* fp, const char* name, const solver_result_t* result)
+{
+    fprintf(fp, "%s:", name);
+
+    if (result == NULL)
+    {
+        fprintf(fp, " error\n");
+        return;
+    }
+
+    for (size_t p = 0U; p < SOLVER_NUM_PARTS; p++)
+    {
+        const char* a = result->answer[p];
+        fputc(' ', fp);
+        if (*a == '\0')
+            fputc('-', fp);
+        for (; *a != '\0'; a++)
+            fputc((*a == '\n') ? '/' : *a, fp);
+    }
+    fputc('\n', fp);
+}
+
+static int
+file_list_add(file_list_t* fl, const char* name)
+{
+    if (fl->used >= fl->size)
+    {
+        size_t size = fl->size + CHUNK_SIZE;
+        char** names = realloc(fl->names, size * sizeof(char*));
+        if (names == NULL)
+            return 0;
+        fl->names = names;
+        fl->size = size;
+    }
+
+    fl->names[fl->used] = strdup(name);
+    if (fl->names[fl->used] == NULL)
+        return 0;
+    fl->used++;
+
+    return 1;
+}
+
+static int
+file_list_read_manifest(file_list_t* fl, const char* manifest)
+{
+    FILE* fp = (strcmp(manifest, "-") == 0) ? stdin : fopen(manifest, "r");
+    if (!fp)
+        return 0;
+
+    int r = 1;
+    char line_buf[MAX_LINE_SIZE];
+    while (r && fgets(line_buf, MAX_LINE_SIZE, fp))
+    {
+        line_buf[strcspn(line_buf, "\r\n")] = '\0';
+        /* skip empty lines and comments */
+        if ((line_buf[0] != '\0') && (line_buf[0] != '#'))
+            r = file_list_add(fl, line_buf);
+    }
+
+    if (fp != stdin)
+        fclose(fp);
+
+    return r;
+}
+
+static void
+file_list_free(file_list_t* fl)
+{
+    for (size_t i = 0U; i < fl->used; i++)
+        free(fl->names[i]);
+    free(fl->names);
+    fl->names = NULL;
+    fl->used = 0U;
+    fl->size = 0U;
+}
+
+static int
+solve_file(const solver_t* s, void* state, const char* name, FILE* log,
+           solver_result_t* result)
+{
+    FILE* fp = fopen(name, "r");
+
+    if (!fp)
+    {
+        fprintf(stderr, "Could not open file %s!\n", name);
+        return 0;
+    }
+
+    memset(result, 0, sizeof(solver_result_t));
+    int r = s->solve(state, fp, log, result);
+
+    fclose(fp);
+
+    return r;
+}
+
+static int
+run_verbose(const solver_t* s, const char* name)
+{
+    printf("Advent of Code 2022 - %s\n\n", s->title);
+
+    void* state = NULL;
+    if (s->create != NULL)
+    {
+        state = s->create();
+        if (state == NULL)
+        {
+            fprintf(stderr, "Not enough memory!");
+            return 0;
+        }
+    }
+
+    solver_result_t result;
+    int r = solve_file(s, state, name, stdout, &result);
+    if (r)
+    {
+        for (size_t p = 0U; p < SOLVER_NUM_PARTS; p++)
+        {
+            const char* a = result.answer[p];
+            if (*a == '\0')
+                continue;
+            if (strchr(a, '\n') != NULL) /* multi-line answer */
+                printf("Part %u: %s:\n%s\n", (unsigned) p + 1U, s->part[p], a);
+            else
+                printf("Part %u: %s = %s\n", (unsigned) p + 1U, s->part[p], a);
+        }
+    }
+
+    if (s->destroy != NULL)
+        s->destroy(state);
+
+    return r;
+}
+
+static int
+run_batch(const solver_t* s, const file_list_t* fl, size_t threads)
+{
+    batch_t batch;
+    batch.solver = s;
+    batch.files = fl;
+    batch.next = 0U;
+    batch.results = malloc(fl->used * sizeof(solver_result_t));
+    batch.success = calloc(fl->used, sizeof(int));
+    if ((batch.results == NULL) || (batch.success == NULL))
+    {
+        fprintf(stderr, "Not enough memory!");
+        free(batch.results);
+        free(batch.success);
+        return 0;
+    }
+
+    if (threads > fl->used)
+        threads = fl->used;
+    batch.parallel = (threads > 1U);
+
+    if (threads <= 1U)
+    {
+        (void) batch_worker(&batch);
+    }
+    else
+    {
+        pthread_t tid[MAX_THREADS];
+        size_t started = 0U;
+        pthread_mutex_init(&batch.lock, NULL);
+        for (; started < threads; started++)
+            if (pthread_create(&tid[started], NULL, batch_worker, &batch) != 0)
+                break;
+        if (started == 0U) /* fall back to the calling thread */
+            (void) batch_worker(&batch);
+        for (size_t t = 0U; t < started; t++)
+            pthread_join(tid[t], NULL);
+        pthread_mutex_destroy(&batch.lock);
+    }
+
+    int r = 1;
+    for (size_t i = 0U; i < fl->used; i++)
+    {
+        solver_print_line(stdout, fl->names[i], batch.success[i] ? &batch.results[i] : NULL);
+        if (!batch.success[i])
+            r = 0;
+    }
+
+    free(batch.results);
+    free(batch.success);
+
+    return r;
+}
+
+static void*
+batch_worker(void* arg)
+{
+    batch_t* b = arg;
+    const solver_t* s = b->solver;
+
+    /* one state per worker, reused for all inputs it takes */
+    void* state = NULL;
+    if (s->create != NULL)
+    {
+        state = s->create();
+        if (state == NULL)
+            return NULL; /* inputs are taken by other workers or fail */
+    }
+
+    for (;;)
+    {
+        if (b->parallel)
+            pthread_mutex_lock(&b->lock);
+        size_t i = b->next++;
+        if (b->parallel)
+            pthread_mutex_unlock(&b->lock);
+        if (i >= b->files->used)
+            break;
+        b->success[i] = solve_file(s, state, b->files->names[i], NULL, &b->results[i]);
+    }
+
+    if (s->destroy != NULL)
+        s->destroy(state);
+
+    return NULL;
+}
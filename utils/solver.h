@@ -0,0 +1,124 @@
+/*
+ * Common interface of all puzzle solvers and batch processing of inputs.
+ *
+ * (C) Copyright 2022 "piscilus" Julian Kraemer
+ *
+ * Distributed under MIT license.
+ * See file LICENSE for details or copy at https://opensource.org/licenses/MIT
+ */
+
+#ifndef SOLVER_H_
+#define SOLVER_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SOLVER_ANSWER_SIZE (256U) /* max length of an answer, incl. NUL */
+#define SOLVER_NUM_PARTS   (2U)
+
+/**
+ * \brief Answers of a solved puzzle input.
+ *
+ * An empty string marks a part that has not been solved (yet).
+ */
+typedef struct
+{
+    char answer[SOLVER_NUM_PARTS][SOLVER_ANSWER_SIZE];
+} solver_result_t;
+
+/**
+ * \brief Description of a puzzle solver.
+ *
+ * A solver keeps everything it wants to reuse between several inputs (e.g.
+ * large buffers) in a state object. Each state is used by one thread at a
+ * time only, so different states can solve inputs concurrently. Therefore a
+ * solver must not keep any other mutable static data and must not call non
+ * reentrant functions like strtok().
+ */
+typedef struct
+{
+    const char* name;                      /* e.g. "day01" */
+    const char* title;                     /* title of the puzzle */
+    const char* part[SOLVER_NUM_PARTS];    /* description of the answers */
+
+    /**
+     * \brief Create state object, may be NULL if solver is stateless.
+     *
+     * \return void* State or NULL if allocation failed.
+     */
+    void* (*create)(void);
+
+    /**
+     * \brief Solve the puzzle for given input.
+     *
+     * \param[in,out] state  State created by create() or NULL.
+     * \param[in]     fp     Puzzle input.
+     * \param[in]     log    Stream for verbose output, may be NULL.
+     * \param[out]    result Answers.
+     *
+     * \return int
+     * \retval 0 Failure, invalid input or not enough memory.
+     * \retval 1 Success.
+     */
+    int (*solve)(void* state, FILE* fp, FILE* log, solver_result_t* result);
+
+    /**
+     * \brief Destroy state object, may be NULL if solver is stateless.
+     *
+     * \param[in] state State created by create().
+     */
+    void (*destroy)(void* state);
+} solver_t;
+
+/**
+ * \brief Main function shared by all solver programs.
+ *
+ * Usage: program [-b] [-j threads] [-m manifest] file...
+ *
+ * A single file without any option is solved verbosely. Otherwise all files
+ * (given as arguments and/or listed in the manifest, one per line, "-" reads
+ * the manifest from stdin) are solved in batch mode: states are reused between
+ * inputs, up to the given number of threads process the files in parallel and
+ * one line "file: answer1 answer2" is printed per file in the given order.
+ *
+ * \param[in] solver Solver to use.
+ * \param[in] argc   Argument count as passed to main().
+ * \param[in] argv   Arguments as passed to main().
+ *
+ * \return int EXIT_SUCCESS or EXIT_FAILURE if any input failed.
+ */
+int
+solver_main(const solver_t* solver, int argc, char* argv[]);
+
+/**
+ * \brief Store the answer of a part.
+ *
+ * \param[out] result Result to write to.
+ * \param[in]  part   Number of the part, 1 or 2.
+ * \param[in]  format printf() like format string.
+ */
+void
+solver_answer(solver_result_t* result, size_t part, const char* format, ...);
+
+/**
+ * \brief Print verbose output.
+ *
+ * \param[in] log    Stream to print to, nothing is printed if NULL.
+ * \param[in] format printf() like format string.
+ */
+void
+solver_log(FILE* log, const char* format, ...);
+
+/**
+ * \brief Print one line "name: answer1 answer2".
+ *
+ * Unsolved parts are printed as "-", line breaks within answers as "/".
+ *
+ * \param[in] fp     Stream to print to.
+ * \param[in] name   Name of the input.
+ * \param[in] result Answers or NULL if solving failed.
+ */
+void
+solver_print_line(FILE* fp, const char* name, const solver_result_t* result);
+
+#endif /* SOLVER_H_ */